@@ -511,9 +511,15 @@ struct Library_corlib_native_System_Convert
     NANOCLR_NATIVE_DECLARE(FromBase64String___STATIC__SZARRAY_U1__STRING);
 
     //--//
-    static double GetDoubleFractionalPart(char *str, int length);
-    static int64_t GetIntegerPart(char *str, int length);
+    static const char *ParseDecimalInteger(
+        const char *str,
+        const char *end,
+        bool &isNegative,
+        uint64_t &magnitude,
+        bool &overflow);
+    static const char *ParseDouble(const char *str, const char *end, double &value, bool &isExact);
     static int64_t GetIntegerFromHexString(char *str);
+    static void EncodeBase64(const unsigned char *src, size_t length, char *dst, bool insertLineBreaks);
     static char *Nano_strptime(const char *buf, const char *fmt, uint64_t *ticks);
 };
 
@@ -681,7 +687,8 @@ struct Library_corlib_native_System_Number
     static int ReplaceNegativeSign(char *buffer, int bufferContentLength, char *negativeSign);
     static int ReplaceDecimalSeparator(char *buffer, int bufferContentLength, char *decimalSeparator);
     static int InsertGroupSeparators(char *buffer, int bufferContentLength, int groupSize, char *groupSep);
-    static const char *GetPrintfLengthModifier(CLR_DataType dataType);
+    static int FormatInteger(char *buffer, CLR_RT_HeapBlock *value, int minDigits);
+    static int FormatHex(char *buffer, CLR_RT_HeapBlock *value, int minDigits, char formatChar);
     static int Format_G(
         char *buffer,
         CLR_RT_HeapBlock *value,
@@ -21,15 +21,13 @@ HRESULT Library_corlib_native_System_Convert::
 {
     NANOCLR_HEADER();
 
-    char *endptr;
     int64_t result = 0;
+    const char *end;
 
 #if (SUPPORT_ANY_BASE_CONVERSION == TRUE)
     // convert via strtoll / strtoull
+    char *endptr;
     int error_code;
-#else
-    uint64_t intPart = 0;
-    uint64_t lastValue = 0;
 #endif
 
     char *str = (char *)stack.Arg0().RecoverString();
@@ -53,16 +51,81 @@ HRESULT Library_corlib_native_System_Convert::
     // check string parameter for null
     FAULT_ON_NULL_ARG(str);
 
+    end = str + stack.Arg0().DereferenceString()->GetLengthInBytes();
+
     // allow spaces before digits
     while (*str == ' ')
     {
         str++;
     }
-    endptr = NULL;
+
+    if (radix == 10)
+    {
+        // base 10 is by far the most common, parse it straight from the string text
+        uint64_t magnitude;
+        bool overflow;
+        const char *next = ParseDecimalInteger(str, end, negReturnExpected, magnitude, overflow);
+
+        if (next == NULL)
+        {
+            NANOCLR_SET_AND_LEAVE(CLR_E_FORMAT_EXCEPTION);
+        }
+
+        // allow spaces after digits
+        while (next < end && *next == ' ')
+        {
+            next++;
+        }
+
+        // should reach end of string no aditional chars
+        if (next != end)
+        {
+            NANOCLR_SET_AND_LEAVE(CLR_E_FORMAT_EXCEPTION);
+        }
+
+        if (overflow)
+        {
+            NANOCLR_SET_AND_LEAVE(CLR_E_OUT_OF_RANGE);
+        }
+
+        if (negReturnExpected)
+        {
+            // it's ok to use -0 even for unsigned types, but otherwise - NO.
+            if (isSigned == false && magnitude > 0)
+            {
+                NANOCLR_SET_AND_LEAVE(CLR_E_OUT_OF_RANGE);
+            }
+
+            // too big to make a negative value?
+            if (magnitude > (uint64_t)0 - (uint64_t)minValue)
+            {
+                NANOCLR_SET_AND_LEAVE(CLR_E_OUT_OF_RANGE);
+            }
+
+            result = (int64_t)((uint64_t)0 - magnitude);
+        }
+        else
+        {
+            if (isUInt64 == false && magnitude > (uint64_t)maxValue)
+            {
+                NANOCLR_SET_AND_LEAVE(CLR_E_OUT_OF_RANGE);
+            }
+
+            // this MAY have made the result negative by overflowing the buffer - which we do
+            // for uint64 logic.  The c# code will cast the int64 to uint64 removing the sign
+            result = (int64_t)magnitude;
+        }
+
+        stack.SetResult_I8(result);
+
+        NANOCLR_SET_AND_LEAVE(S_OK);
+    }
 
 #if (SUPPORT_ANY_BASE_CONVERSION == TRUE)
     // support for conversion from any base
 
+    endptr = NULL;
+
     if (*str == '-')
     {
         negReturnExpected = true;
@@ -142,97 +205,8 @@ HRESULT Library_corlib_native_System_Convert::
 
 #else
 
-    // support for conversion from base 10 and 16 (partial)
-    if (radix == 10)
-    {
-        // conversion from base 10
-
-        // check for minus sign
-        if (*str == '-')
-        {
-            negReturnExpected = true;
-            str++;
-        }
-        else if (*str == '+')
-        {
-            str++;
-        }
-
-        intPart = 0;
-        lastValue = 0;
-
-        // guess at no more than 99 characters
-        for (int i = 0; i < 99; i++)
-        {
-            if (*str < '0' || *str > '9')
-            {
-                endptr = str;
-
-                // allow spaces after digits
-                while (*endptr == ' ')
-                {
-                    endptr++;
-                }
-
-                // should reach end of string no aditional chars
-                if (*endptr == 0)
-                {
-                    break;
-                }
-
-                // non-numeric (and not trailing space)
-                NANOCLR_SET_AND_LEAVE(CLR_E_FORMAT_EXCEPTION);
-            }
-
-            // advance the digits and add the current number
-            intPart = (intPart * 10) + (*str - '0');
-
-            if (intPart < lastValue)
-            {
-                // the above operation overflowed the value
-                NANOCLR_SET_AND_LEAVE(CLR_E_OUT_OF_RANGE);
-            }
-
-            lastValue = intPart;
-
-            str++;
-            if (*str == '\0')
-            {
-                break;
-            }
-        }
-
-        // intPart now holds a positive number from the string.
-        if (negReturnExpected)
-        {
-            // it's ok to use -0 even for unsigned types, but otherwise - NO.
-            if (isSigned == false && intPart > 0)
-            {
-                NANOCLR_SET_AND_LEAVE(CLR_E_OUT_OF_RANGE);
-            }
-
-            // too big to make a negative value?
-            if (intPart > (uint64_t)(minValue * -1))
-            {
-                NANOCLR_SET_AND_LEAVE(CLR_E_OUT_OF_RANGE);
-            }
-
-            result = intPart * -1;
-        }
-        else
-        {
-            // result will be negative for large uints, and we checked for overflow above
-            if (isUInt64 == false && intPart > (uint64_t)maxValue)
-            {
-                NANOCLR_SET_AND_LEAVE(CLR_E_OUT_OF_RANGE);
-            }
-
-            // this MAY have made the result negative by overflowing the buffer - which we do
-            // for uint64 logic.  The c# code will cast the int64 to uint64 removing the sign
-            result = (int64_t)intPart;
-        }
-    }
-    else if (radix == 16)
+    // besides base 10 only base 16 is supported (partial)
+    if (radix == 16)
     {
         // conversion from base 16
         result = GetIntegerFromHexString(str);
@@ -272,26 +246,9 @@ HRESULT Library_corlib_native_System_Convert::NativeToDouble___STATIC__R8__STRIN
     NANOCLR_HEADER();
 
     double returnValue = 0;
-
-#if (SUPPORT_ANY_BASE_CONVERSION == TRUE)
-
-    char *endptr;
-
-#else
-
-    int endOrExponentialPart;
-    int exponent;
-    double outExponent;
-    int length = 0;
-    bool hasMinusSign = false;
-    bool hasPlusSign = false;
-    int decimalPoint = -1;
-    int exponentialSign = -1;
-    bool hasMinusExponentialSign = false;
-    bool hasPlusExponentialSign = false;
-    char *temp;
-
-#endif
+    bool isExact = false;
+    const char *end;
+    const char *next;
 
     char *str = (char *)stack.Arg0().RecoverString();
 
@@ -301,205 +258,51 @@ HRESULT Library_corlib_native_System_Convert::NativeToDouble___STATIC__R8__STRIN
     // check string parameter for null
     FAULT_ON_NULL_ARG(str);
 
+    end = str + stack.Arg0().DereferenceString()->GetLengthInBytes();
+
     // skip spaces before digits
     while (*str == ' ')
     {
         str++;
     }
 
-#if (SUPPORT_ANY_BASE_CONVERSION == TRUE)
-    // support for conversion from any base
-
-    endptr = str;
+    next = ParseDouble(str, end, returnValue, isExact);
 
-    // notice we don't try to catch errno=ERANGE - IEEE574 says overflows should just convert to infinity values
-    returnValue = strtod(str, &endptr);
+#if (SUPPORT_ANY_BASE_CONVERSION == TRUE)
 
-    if (endptr == str)
+    // strtod takes whatever can't be converted exactly with the fast path, or isn't a plain number (inf, nan, hex)
+    if (next == NULL || !isExact || (next != end && *next != ' '))
     {
-        // didn't parse the string completely
-        NANOCLR_SET_AND_LEAVE(CLR_E_FORMAT_EXCEPTION);
-    }
+        char *endptr = str;
 
-    // allow spaces after digits
-    while (*endptr == ' ')
-    {
-        endptr++;
-    }
+        // notice we don't try to catch errno=ERANGE - IEEE574 says overflows should just convert to infinity values
+        returnValue = strtod(str, &endptr);
 
-    // should reach end of string no aditional chars
-    if (*endptr != 0)
-    {
-        NANOCLR_SET_AND_LEAVE(CLR_E_FORMAT_EXCEPTION);
+        next = (endptr == str) ? NULL : endptr;
     }
 
-    stack.SetResult_R8(returnValue);
-
-#else
-
-    // support for conversion from base 10 and 16 (partial)
-    // in this particular function the base isn't relevant
-
-    // first pass, get count of decimal places, integer part and check for valid chars
-    temp = str;
+#endif
 
-    while (*temp != '\0')
+    if (next == NULL)
     {
-        switch (*temp)
-        {
-            case '-':
-                if (exponentialSign == -1)
-                {
-                    if (length == 0 && hasMinusSign == false)
-                    {
-                        hasMinusSign = true;
-
-                        // point past the leading sign
-                        str++;
-
-                        // don't count this in the length
-                        length--;
-                    }
-                    else
-                    {
-                        // found a minus signal NOT at the start of the string
-                        NANOCLR_SET_AND_LEAVE(CLR_E_FORMAT_EXCEPTION);
-                    }
-                }
-                else
-                {
-                    if (length == exponentialSign + 1)
-                    {
-                        hasMinusExponentialSign = true;
-                    }
-                    else
-                    {
-                        // found a minus signal NOT at the start of the exponent
-                        NANOCLR_SET_AND_LEAVE(CLR_E_FORMAT_EXCEPTION);
-                    }
-                }
-                break;
-
-            case '+':
-                if (exponentialSign == -1)
-                {
-                    if (length == 0 && hasPlusSign == false)
-                    {
-                        hasPlusSign = true;
-
-                        // point past the leading sign
-                        str++;
-
-                        // don't count this in the length
-                        length--;
-                    }
-                    else
-                    {
-                        // found a plus signal NOT at the start of the string
-                        NANOCLR_SET_AND_LEAVE(CLR_E_FORMAT_EXCEPTION);
-                    }
-                }
-                else
-                {
-                    if (length == exponentialSign + 1)
-                    {
-                        hasPlusExponentialSign = true;
-                    }
-                    else
-                    {
-                        // found a plus signal NOT at the start of the exponent
-                        NANOCLR_SET_AND_LEAVE(CLR_E_FORMAT_EXCEPTION);
-                    }
-                }
-                break;
-
-            case '.':
-                if (decimalPoint == -1)
-                {
-                    decimalPoint = length;
-                }
-                else
-                {
-                    // already found a decimal point, can't have another
-                    NANOCLR_SET_AND_LEAVE(CLR_E_FORMAT_EXCEPTION);
-                }
-                break;
-
-            case 'e':
-            case 'E':
-                if (exponentialSign == -1)
-                {
-                    exponentialSign = length;
-                }
-                else
-                {
-                    // already found a exponential sign, can't have another
-                    NANOCLR_SET_AND_LEAVE(CLR_E_FORMAT_EXCEPTION);
-                }
-                break;
-
-            default:
-                if (*temp < '0' || *temp > '9')
-                {
-                    // there is an invalid char in the string
-                    NANOCLR_SET_AND_LEAVE(CLR_E_FORMAT_EXCEPTION);
-                }
-        }
-        length++;
-        temp++;
+        // there is no number in the string
+        NANOCLR_SET_AND_LEAVE(CLR_E_FORMAT_EXCEPTION);
     }
 
-    //  now parse the string according to it's format
-    endOrExponentialPart = exponentialSign == -1 ? length : exponentialSign;
-    if (decimalPoint == -1)
-    {
-        // string doesn't have fractional part, treat as integer
-        returnValue = GetIntegerPart(str, endOrExponentialPart);
-    }
-    else if (decimalPoint == 0)
+    // allow spaces after digits
+    while (next < end && *next == ' ')
     {
-        // string starts with the decimal point, only has fractional part
-        returnValue = GetDoubleFractionalPart((str + decimalPoint + 1), (endOrExponentialPart - decimalPoint - 1));
-    }
-    else
-    {
-        // string has integer and fractional parts
-        returnValue = GetIntegerPart(str, decimalPoint);
-        returnValue =
-            returnValue + GetDoubleFractionalPart((str + decimalPoint + 1), (endOrExponentialPart - decimalPoint - 1));
-        if (hasMinusSign)
-        {
-            returnValue *= -1;
-        }
+        next++;
     }
 
-    // exponential part found?
-    if (exponentialSign != -1)
+    // should reach end of string no aditional chars
+    if (next != end)
     {
-        // advance by one if a sign (+ or -) is after the exponential sign
-        if (hasMinusExponentialSign || hasPlusExponentialSign)
-        {
-            exponentialSign++;
-        }
-
-        // get the exponential part
-        exponent = GetIntegerPart((str + exponentialSign + 1), (length - exponentialSign - 1));
-        outExponent = pow(10, exponent);
-
-        if (hasMinusExponentialSign)
-        {
-            returnValue = returnValue / outExponent;
-        }
-        else
-        {
-            returnValue = returnValue * outExponent;
-        }
+        NANOCLR_SET_AND_LEAVE(CLR_E_FORMAT_EXCEPTION);
     }
 
     stack.SetResult_R8(returnValue);
 
-#endif // defined(SUPPORT_ANY_BASE_CONVERSION)
-
     NANOCLR_CLEANUP();
 
     // set parameter reporting conversion success/failure
@@ -512,7 +315,7 @@ HRESULT Library_corlib_native_System_Convert::NativeToDouble___STATIC__R8__STRIN
         hr = S_OK;
 
         // need to set result value to 0
-        stack.SetResult_R8(returnValue);
+        stack.SetResult_R8(0);
     }
 
     NANOCLR_CLEANUP_END();
@@ -592,13 +395,10 @@ HRESULT Library_corlib_native_System_Convert::ToBase64String___STATIC__STRING__S
 #if (SUPPORT_ANY_BASE_CONVERSION == TRUE)
 
     size_t outputLength;
-    unsigned char *outArray = NULL;
-    char *outArrayWitLineBreak = NULL;
+    size_t lineBreakCount = 0;
     unsigned char *inArrayPointer = NULL;
-    size_t lineBreakCount;
-    uint16_t offsetIndex = 0;
-    size_t count = 0;
-    int result;
+    CLR_RT_HeapBlock_String *outString;
+    char *outText;
 
     CLR_RT_HeapBlock_Array *inArray = stack.Arg0().DereferenceArray();
     size_t offset = (size_t)stack.Arg1().NumericByRef().s4;
@@ -613,93 +413,21 @@ HRESULT Library_corlib_native_System_Convert::ToBase64String___STATIC__STRING__S
     // compute base64 string length
     outputLength = 4 * ((length + 2) / 3);
 
-    // need malloc with base64 string length plus string terminator (+1)
-    outArray = (unsigned char *)platform_malloc(outputLength + 1);
-
-    // check if have allocation
-    if (outArray == NULL)
+    if (insertLineBreaks && outputLength > 0)
     {
-        NANOCLR_SET_AND_LEAVE(CLR_E_OUT_OF_MEMORY);
+        // line break (CR + LF) between each line of 76 chars
+        lineBreakCount = (outputLength - 1) / 76;
     }
 
-    // perform the operation
-    // need to tweak the parameter with the output length because it includes room for the terminator
-    result = mbedtls_base64_encode(outArray, (outputLength + 1), &outputLength, inArrayPointer, length);
+    // encode straight into the string storage, no intermediate buffers
+    outString = CLR_RT_HeapBlock_String::CreateInstance(stack.PushValue(), outputLength + (lineBreakCount * 2));
+    CHECK_ALLOCATION(outString);
 
-    if (result != 0)
-    {
-        // internal error occurred
-        NANOCLR_SET_AND_LEAVE(CLR_E_FAIL);
-    }
+    outText = (char *)outString->StringText();
 
-    if (insertLineBreaks)
-    {
-        // get line break count (line break every 76 chars)
-        lineBreakCount = outputLength / 76;
+    EncodeBase64(inArrayPointer, length, outText, lineBreakCount > 0);
 
-        // need malloc with base64 string length plus line breaks (line break is 2 char long: CR + LF) plus final line
-        // break
-        outArrayWitLineBreak = (char *)platform_malloc(outputLength + (lineBreakCount * 2) + 2);
-
-        for (size_t i = 0; i <= lineBreakCount; i++)
-        {
-            // how many chars to copy
-            if (outputLength > 76)
-            {
-                // first/next 76 chars
-                count = 76;
-            }
-            else
-            {
-                // last outputLength chars
-                count = outputLength;
-            }
-
-            // copy first/next count chars
-            // because we are using same offset for both arrays, we need to discount line break for tmp array
-            memcpy(outArrayWitLineBreak + offsetIndex, outArray + (offsetIndex - (i * 2)), count);
-
-            // remove copied chars from original output length if more than 76 chars still to be copied
-            if (outputLength >= 76)
-            {
-                // more chars
-
-                // adjust output length
-                outputLength -= 76;
-
-                // add line break
-                outArrayWitLineBreak[count + offsetIndex] = '\r';
-                outArrayWitLineBreak[count + offsetIndex + 1] = '\n';
-
-                // move offset for next copy (including line break +2)
-                offsetIndex += count + 2;
-            }
-            else
-            {
-                // move offset for last position
-                offsetIndex += count;
-                // reached end of array, add terminator
-                outArrayWitLineBreak[offsetIndex] = 0;
-            }
-        }
-        // set a return result in the stack argument using the appropriate SetResult according to the variable type (a
-        // string here)
-        NANOCLR_CHECK_HRESULT(stack.SetResult_String(outArrayWitLineBreak));
-    }
-    else
-    {
-        // set a return result in the stack argument using the appropriate SetResult according to the variable type (a
-        // string here)
-        NANOCLR_CHECK_HRESULT(stack.SetResult_String((const char *)outArray));
-    }
-
-    // need to free memory from arrays
-    platform_free((void *)outArray);
-
-    if (outArrayWitLineBreak != NULL)
-    {
-        platform_free((void *)outArrayWitLineBreak);
-    }
+    outString->SetAsciiTextInfo(outputLength + (lineBreakCount * 2));
 
 #else
 
@@ -717,9 +445,10 @@ HRESULT Library_corlib_native_System_Convert::FromBase64String___STATIC__SZARRAY
 #if (SUPPORT_ANY_BASE_CONVERSION == TRUE)
 
     CLR_RT_HeapBlock_String *inString = NULL;
+    CLR_RT_HeapBlock_Array *outArray;
+    const unsigned char *inText;
     size_t outputLength;
-    unsigned char *outArray = NULL;
-    CLR_UINT8 *returnArray;
+    size_t decodedLength;
     int result;
     size_t length;
 
@@ -728,101 +457,308 @@ HRESULT Library_corlib_native_System_Convert::FromBase64String___STATIC__SZARRAY
 
     FAULT_ON_NULL_ARG(inString->StringText());
 
-    length = hal_strlen_s(inString->StringText());
+    inText = (const unsigned char *)inString->StringText();
+    length = inString->GetLengthInBytes();
 
-    // estimate output length
-    outputLength = length / 4 * 3;
+    // 1st pass validates the input and gets the output length
+    result = mbedtls_base64_decode(NULL, 0, &outputLength, inText, length);
 
-    // alloc output array
-    outArray = (unsigned char *)platform_malloc(outputLength + 1);
-    // check malloc success
-    if (outArray == NULL)
+    if (result != 0 && result != MBEDTLS_ERR_BASE64_BUFFER_TOO_SMALL)
     {
-        NANOCLR_SET_AND_LEAVE(CLR_E_OUT_OF_MEMORY);
+        // invalid input
+        NANOCLR_SET_AND_LEAVE(CLR_E_FAIL);
     }
 
-    memset(outArray, 0, outputLength + 1);
+    // create heap block array instance with appropriate size (the length of the output array)
+    // and type (byte which is uint8_t)
+    NANOCLR_CHECK_HRESULT(
+        CLR_RT_HeapBlock_Array::CreateInstance(stack.PushValueAndClear(), outputLength, g_CLR_RT_WellKnownTypes.m_UInt8));
 
-    // perform the operation
-    // need to tweak the parameter with the output length because it includes room for the terminator
-    result = mbedtls_base64_decode(
-        outArray,
-        (outputLength + 1),
-        &outputLength,
-        (const unsigned char *)inString->StringText(),
-        length);
+    outArray = stack.TopValue().DereferenceArray();
 
-    if (result != 0)
+    if (outputLength > 0)
     {
-        // internal error occurred
-        NANOCLR_SET_AND_LEAVE(CLR_E_FAIL);
+        // 2nd pass decodes straight into the array
+        result = mbedtls_base64_decode(outArray->GetFirstElement(), outputLength, &decodedLength, inText, length);
+
+        // the length is only an estimate when the number of chars isn't a multiple of 4, which isn't valid input
+        if (result != 0 || decodedLength != outputLength)
+        {
+            NANOCLR_SET_AND_LEAVE(CLR_E_FAIL);
+        }
     }
 
-    // create heap block array instance with appropriate size (the length of the output array)
-    // and type (byte which is uint8_t)
-    NANOCLR_CHECK_HRESULT(CLR_RT_HeapBlock_Array::CreateInstance(
-        stack.PushValueAndClear(),
-        outputLength,
-        g_CLR_RT_WellKnownTypes.m_UInt8));
+#else
 
-    // get a pointer to the array in the heap block array just created
-    returnArray = stack.TopValue().DereferenceArray()->GetFirstElement();
+    NANOCLR_SET_AND_LEAVE(stack.NotImplementedStub());
 
-    // copy outArray to the returnArray
-    memcpy(returnArray, outArray, outputLength);
+#endif
 
-    NANOCLR_CLEANUP();
+    NANOCLR_NOCLEANUP();
+}
+
+void Library_corlib_native_System_Convert::EncodeBase64(
+    const unsigned char *src,
+    size_t length,
+    char *dst,
+    bool insertLineBreaks)
+{
+    // 19 groups of 3 bytes make a line of 76 chars
+    int groupsInLine = 0;
 
-    if (outArray)
+    while (length >= 3)
     {
-        // need to free memory from outArray
-        platform_free(outArray);
-    }
+        uint32_t group = ((uint32_t)src[0] << 16) | ((uint32_t)src[1] << 8) | src[2];
 
-    NANOCLR_CLEANUP_END();
+        dst[0] = base64_enc_map[(group >> 18) & 0x3F];
+        dst[1] = base64_enc_map[(group >> 12) & 0x3F];
+        dst[2] = base64_enc_map[(group >> 6) & 0x3F];
+        dst[3] = base64_enc_map[group & 0x3F];
 
-#else
+        src += 3;
+        dst += 4;
+        length -= 3;
 
-    NANOCLR_SET_AND_LEAVE(stack.NotImplementedStub());
+        if (insertLineBreaks && ++groupsInLine == 19 && length > 0)
+        {
+            *dst++ = '\r';
+            *dst++ = '\n';
+            groupsInLine = 0;
+        }
+    }
 
-    NANOCLR_NOCLEANUP();
+    if (length > 0)
+    {
+        uint32_t group = ((uint32_t)src[0] << 16) | ((length > 1) ? ((uint32_t)src[1] << 8) : 0);
 
-#endif
+        dst[0] = base64_enc_map[(group >> 18) & 0x3F];
+        dst[1] = base64_enc_map[(group >> 12) & 0x3F];
+        dst[2] = (length > 1) ? base64_enc_map[(group >> 6) & 0x3F] : '=';
+        dst[3] = '=';
+    }
 }
 
-double Library_corlib_native_System_Convert::GetDoubleFractionalPart(char *str, int length)
+// powers of 10 that are exactly representable as a double
+static const double c_ExactPowersOf10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                           1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+#define MAX_EXACT_POWER_OF_10   22
+#define MAX_EXACT_DOUBLE_INTEGER ((uint64_t)1 << 53)
+
+const char *Library_corlib_native_System_Convert::ParseDecimalInteger(
+    const char *str,
+    const char *end,
+    bool &isNegative,
+    uint64_t &magnitude,
+    bool &overflow)
 {
-    double place = 1;
-    double returnValue = 0.0;
+    const char *start;
+
+    isNegative = false;
+    magnitude = 0;
+    overflow = false;
+
+    if (str < end && (*str == '-' || *str == '+'))
+    {
+        isNegative = (*str == '-');
+        str++;
+    }
+
+    start = str;
 
-    for (int i = 0; i < length; i++)
+    while (str < end)
     {
-        // move decimal place to the right
-        place /= 10.0;
+        unsigned int digit = (unsigned int)(*str - '0');
+
+        if (digit > 9)
+        {
+            break;
+        }
+
+        // magnitude * 10 + digit would go past 2^64 - 1
+        if (magnitude > (UINT64_MAX - digit) / 10)
+        {
+            overflow = true;
+        }
 
-        returnValue += ((int)(*str++) - '0') * place;
+        magnitude = magnitude * 10 + digit;
+        str++;
     }
 
-    return returnValue;
+    return (str == start) ? NULL : str;
 }
 
-int64_t Library_corlib_native_System_Convert::GetIntegerPart(char *str, int length)
+const char *Library_corlib_native_System_Convert::ParseDouble(
+    const char *str,
+    const char *end,
+    double &value,
+    bool &isExact)
 {
-    int64_t returnValue = 0;
+    uint64_t mantissa = 0;
+    int numDigits = 0;
+    int exponent = 0;
+    bool truncated = false;
+    bool isNegative = false;
+    bool hasDigits = false;
+    unsigned int digit;
+
+    value = 0;
+    isExact = false;
+
+    if (str < end && (*str == '-' || *str == '+'))
+    {
+        isNegative = (*str == '-');
+        str++;
+    }
+
+    // integer part, only the first 19 significant digits fit the mantissa
+    while (str < end && (digit = (unsigned int)(*str - '0')) <= 9)
+    {
+        hasDigits = true;
+
+        if (numDigits < 19)
+        {
+            mantissa = mantissa * 10 + digit;
+
+            // leading zeros aren't significant
+            if (mantissa != 0)
+            {
+                numDigits++;
+            }
+        }
+        else
+        {
+            exponent++;
+            truncated |= (digit != 0);
+        }
+
+        str++;
+    }
 
-    for (int i = 0; i < length; i++)
+    // fractional part
+    if (str < end && *str == '.')
     {
-        returnValue = returnValue * 10 + (*str - '0');
         str++;
 
-        // check for terminator, in case this is being called in 'guess' mode
-        if (*str == '\0')
+        while (str < end && (digit = (unsigned int)(*str - '0')) <= 9)
         {
-            break;
+            hasDigits = true;
+
+            if (numDigits < 19)
+            {
+                mantissa = mantissa * 10 + digit;
+                exponent--;
+
+                if (mantissa != 0)
+                {
+                    numDigits++;
+                }
+            }
+            else
+            {
+                truncated |= (digit != 0);
+            }
+
+            str++;
         }
     }
 
-    return returnValue;
+    if (!hasDigits)
+    {
+        return NULL;
+    }
+
+    // exponent part, it's only taken when it has digits
+    if (str < end && (*str == 'e' || *str == 'E'))
+    {
+        const char *exponentStart = str + 1;
+        bool isExponentNegative = false;
+        int explicitExponent = 0;
+
+        if (exponentStart < end && (*exponentStart == '-' || *exponentStart == '+'))
+        {
+            isExponentNegative = (*exponentStart == '-');
+            exponentStart++;
+        }
+
+        if (exponentStart < end && (unsigned int)(*exponentStart - '0') <= 9)
+        {
+            str = exponentStart;
+
+            while (str < end && (digit = (unsigned int)(*str - '0')) <= 9)
+            {
+                // anything this big is already an overflow or underflow
+                if (explicitExponent < 100000)
+                {
+                    explicitExponent = explicitExponent * 10 + digit;
+                }
+
+                str++;
+            }
+
+            exponent += isExponentNegative ? -explicitExponent : explicitExponent;
+        }
+    }
+
+    if (mantissa == 0)
+    {
+        isExact = true;
+    }
+    else if (!truncated && mantissa <= MAX_EXACT_DOUBLE_INTEGER)
+    {
+        // both operands are exact so the single multiplication or division is correctly rounded
+        if (exponent >= -MAX_EXACT_POWER_OF_10 && exponent <= MAX_EXACT_POWER_OF_10)
+        {
+            value = (double)mantissa;
+            value = (exponent < 0) ? value / c_ExactPowersOf10[-exponent] : value * c_ExactPowersOf10[exponent];
+            isExact = true;
+        }
+        else if (exponent > MAX_EXACT_POWER_OF_10)
+        {
+            // move the excess of the exponent to the mantissa as long as it stays exact
+            while (exponent > MAX_EXACT_POWER_OF_10 && mantissa <= MAX_EXACT_DOUBLE_INTEGER / 10)
+            {
+                mantissa *= 10;
+                exponent--;
+            }
+
+            if (exponent <= MAX_EXACT_POWER_OF_10)
+            {
+                value = (double)mantissa * c_ExactPowersOf10[exponent];
+                isExact = true;
+            }
+        }
+    }
+
+    if (!isExact)
+    {
+        // close approximation, scaling in steps of exact powers of 10
+        value = (double)mantissa;
+
+        while (exponent > MAX_EXACT_POWER_OF_10 && value != 0)
+        {
+            value *= c_ExactPowersOf10[MAX_EXACT_POWER_OF_10];
+            exponent -= MAX_EXACT_POWER_OF_10;
+        }
+
+        while (exponent < -MAX_EXACT_POWER_OF_10 && value != 0)
+        {
+            value /= c_ExactPowersOf10[MAX_EXACT_POWER_OF_10];
+            exponent += MAX_EXACT_POWER_OF_10;
+        }
+
+        if (value != 0)
+        {
+            value = (exponent < 0) ? value / c_ExactPowersOf10[-exponent] : value * c_ExactPowersOf10[exponent];
+        }
+    }
+
+    if (isNegative)
+    {
+        value = -value;
+    }
+
+    return str;
 }
 
 int64_t Library_corlib_native_System_Convert::GetIntegerFromHexString(char *str)
@@ -133,16 +133,210 @@ int Library_corlib_native_System_Number::DoPrintfOnDataType(char *buffer, char *
     return ret;
 }
 
-const char *Library_corlib_native_System_Number::GetPrintfLengthModifier(CLR_DataType dataType)
+// two decimal digits per entry, to halve the number of divisions when converting integers
+static const char c_DecimalDigitPairs[] = "00010203040506070809"
+                                          "10111213141516171819"
+                                          "20212223242526272829"
+                                          "30313233343536373839"
+                                          "40414243444546474849"
+                                          "50515253545556575859"
+                                          "60616263646566676869"
+                                          "70717273747576777879"
+                                          "80818283848586878889"
+                                          "90919293949596979899";
+
+static const char c_HexDigitsUpper[] = "0123456789ABCDEF";
+static const char c_HexDigitsLower[] = "0123456789abcdef";
+
+// max number of digits of a 64 bit integer
+#define FORMAT_INTEGER_MAX_DIGITS 20
+
+// writes the decimal digits of value backwards from end, returns a pointer to the first digit
+static char *WriteDecimalDigits(char *end, CLR_UINT32 value)
 {
-    const char *ret = (dataType == DATATYPE_I1 || dataType == DATATYPE_U1)   ? ""
-                      : (dataType == DATATYPE_I2 || dataType == DATATYPE_U2) ? ""
-                      : (dataType == DATATYPE_I4 || dataType == DATATYPE_U4) ? ""
-                      : (dataType == DATATYPE_I8 || dataType == DATATYPE_U8) ? "ll"
-                                                                             : "";
+    while (value >= 100)
+    {
+        const char *pair = &c_DecimalDigitPairs[(value % 100) * 2];
+        value /= 100;
+
+        *--end = pair[1];
+        *--end = pair[0];
+    }
+
+    if (value >= 10)
+    {
+        const char *pair = &c_DecimalDigitPairs[value * 2];
+
+        *--end = pair[1];
+        *--end = pair[0];
+    }
+    else
+    {
+        *--end = (char)('0' + value);
+    }
+
+    return end;
+}
+
+static char *WriteDecimalDigits(char *end, CLR_UINT64 value)
+{
+    // peel off chunks of 9 digits so most of the work is done with 32 bit divisions
+    while (value > 0xFFFFFFFF)
+    {
+        char *chunkStart = end - 9;
+        char *p = WriteDecimalDigits(end, (CLR_UINT32)(value % 1000000000));
+
+        value /= 1000000000;
+
+        while (p > chunkStart)
+        {
+            *--p = '0';
+        }
+
+        end = chunkStart;
+    }
+
+    return WriteDecimalDigits(end, (CLR_UINT32)value);
+}
+
+// fills minDigits with the digits of the number, left padded with zeros, returns the length
+static int WritePaddedDigits(char *buffer, const char *digits, int numDigits, int minDigits)
+{
+    int ret = 0;
+
+    // never go past the result buffer, leaving room for the sign and the terminator
+    if (minDigits > FORMAT_RESULT_BUFFER_SIZE - 2)
+    {
+        minDigits = FORMAT_RESULT_BUFFER_SIZE - 2;
+    }
+
+    while (minDigits-- > numDigits)
+    {
+        buffer[ret++] = '0';
+    }
+
+    memcpy(&buffer[ret], digits, numDigits);
+    ret += numDigits;
+
+    buffer[ret] = 0;
+
     return ret;
 }
 
+int Library_corlib_native_System_Number::FormatInteger(char *buffer, CLR_RT_HeapBlock *value, int minDigits)
+{
+    char digits[FORMAT_INTEGER_MAX_DIGITS];
+    char *end = &digits[FORMAT_INTEGER_MAX_DIGITS];
+    char *start;
+    CLR_INT64 signedValue = 0;
+    CLR_UINT64 magnitude;
+    bool isNegative = false;
+
+    switch (value->DataType())
+    {
+        case DATATYPE_I1:
+            signedValue = value->NumericByRef().s1;
+            break;
+        case DATATYPE_I2:
+            signedValue = value->NumericByRef().s2;
+            break;
+        case DATATYPE_I4:
+            signedValue = value->NumericByRef().s4;
+            break;
+        case DATATYPE_I8:
+            signedValue = value->NumericByRef().s8;
+            break;
+        case DATATYPE_U1:
+            signedValue = value->NumericByRef().u1;
+            break;
+        case DATATYPE_U2:
+            signedValue = value->NumericByRef().u2;
+            break;
+        case DATATYPE_U4:
+            signedValue = value->NumericByRef().u4;
+            break;
+        case DATATYPE_U8:
+            break;
+        default:
+            return -1;
+    }
+
+    if (value->DataType() == DATATYPE_U8)
+    {
+        magnitude = value->NumericByRef().u8;
+    }
+    else if (signedValue < 0)
+    {
+        isNegative = true;
+        magnitude = (CLR_UINT64)0 - (CLR_UINT64)signedValue;
+    }
+    else
+    {
+        magnitude = (CLR_UINT64)signedValue;
+    }
+
+    start = (magnitude > 0xFFFFFFFF) ? WriteDecimalDigits(end, magnitude) : WriteDecimalDigits(end, (CLR_UINT32)magnitude);
+
+    if (isNegative)
+    {
+        buffer[0] = '-';
+
+        return 1 + WritePaddedDigits(&buffer[1], start, (int)(end - start), minDigits);
+    }
+
+    return WritePaddedDigits(buffer, start, (int)(end - start), minDigits);
+}
+
+int Library_corlib_native_System_Number::FormatHex(
+    char *buffer,
+    CLR_RT_HeapBlock *value,
+    int minDigits,
+    char formatChar)
+{
+    const char *hexDigits = (formatChar == 'x') ? c_HexDigitsLower : c_HexDigitsUpper;
+    char digits[FORMAT_INTEGER_MAX_DIGITS];
+    char *end = &digits[FORMAT_INTEGER_MAX_DIGITS];
+    char *start = end;
+    CLR_UINT64 bits;
+
+    // same bits printf gets: the smaller signed types are sign extended to 32 bits
+    switch (value->DataType())
+    {
+        case DATATYPE_I1:
+            bits = (CLR_UINT32)(CLR_INT32)value->NumericByRef().s1;
+            break;
+        case DATATYPE_I2:
+            bits = (CLR_UINT32)(CLR_INT32)value->NumericByRef().s2;
+            break;
+        case DATATYPE_I4:
+            bits = (CLR_UINT32)value->NumericByRef().s4;
+            break;
+        case DATATYPE_U1:
+            bits = value->NumericByRef().u1;
+            break;
+        case DATATYPE_U2:
+            bits = value->NumericByRef().u2;
+            break;
+        case DATATYPE_U4:
+            bits = value->NumericByRef().u4;
+            break;
+        case DATATYPE_I8:
+        case DATATYPE_U8:
+            bits = value->NumericByRef().u8;
+            break;
+        default:
+            return -1;
+    }
+
+    do
+    {
+        *--start = hexDigits[bits & 0xF];
+        bits >>= 4;
+    } while (bits != 0);
+
+    return WritePaddedDigits(buffer, start, (int)(end - start), minDigits);
+}
+
 bool Library_corlib_native_System_Number::IsSignedIntegerDataType(CLR_DataType dataType)
 {
     bool ret =
@@ -398,25 +592,18 @@ int Library_corlib_native_System_Number::Format_G(
 
     if (precision > 0)
     {
-        // compose format string
-        char nonIntegerPrecStr[FORMAT_FMTSTR_BUFFER_SIZE];
-        if (!isIntegerDataType)
+        if (isIntegerDataType)
         {
-            snprintf(nonIntegerPrecStr, FORMAT_FMTSTR_BUFFER_SIZE, "0.%d", precisionForConversion);
+            ret = FormatInteger(buffer, value, 1);
         }
+        else
+        {
+            // compose format string
+            char formatStr[FORMAT_FMTSTR_BUFFER_SIZE];
+            snprintf(formatStr, FORMAT_FMTSTR_BUFFER_SIZE, "%%0.%d%c", precisionForConversion, formatChar);
 
-        char formatStr[FORMAT_FMTSTR_BUFFER_SIZE];
-        snprintf(
-            formatStr,
-            FORMAT_FMTSTR_BUFFER_SIZE,
-            "%%%s%s%c",
-            (isIntegerDataType) ? "" : nonIntegerPrecStr,
-            (isIntegerDataType) ? GetPrintfLengthModifier(dataType) : "",
-            (!isIntegerDataType)                  ? formatChar
-            : (IsSignedIntegerDataType(dataType)) ? 'd'
-                                                  : 'u');
-
-        ret = DoPrintfOnDataType(buffer, formatStr, value);
+            ret = DoPrintfOnDataType(buffer, formatStr, value);
+        }
 
         if (ret > 0)
         {
@@ -590,36 +777,15 @@ int Library_corlib_native_System_Number::Format_D(
 {
     int ret = -1;
 
-    CLR_DataType dataType = value->DataType();
-
     if (precision == -1)
     {
         precision = 0;
     }
 
-    char formatStr[FORMAT_FMTSTR_BUFFER_SIZE];
-    snprintf(
-        formatStr,
-        FORMAT_FMTSTR_BUFFER_SIZE,
-        "%%0%d%s%c",
-        precision,
-        GetPrintfLengthModifier(dataType),
-        (IsSignedIntegerDataType(dataType)) ? 'd' : 'u');
-
-    ret = DoPrintfOnDataType(buffer, formatStr, value);
+    // the precision is the minimum number of digits, not counting the sign
+    ret = FormatInteger(buffer, value, (precision > 0) ? precision : 1);
     if (ret > 0)
     {
-        // printf and ToString differs on negative numbers:
-        // printf("%05d", -123) returns "-0123"
-        // -123.ToString("D5") returns "-00123"
-        if (precision != 0 && ret > 1 && precision >= ret && buffer[0] == '-')
-        {
-            // our buffer defined bigger than the max number string, no worries
-            memmove(&buffer[2], &buffer[1], ret);
-            buffer[1] = '0';
-            ret++;
-        }
-
         ret = ReplaceNegativeSign(buffer, ret, negativeSign);
         ret = ReplaceDecimalSeparator(buffer, ret, decimalSeparator);
     }
@@ -663,16 +829,8 @@ int Library_corlib_native_System_Number::Format_X(char *buffer, CLR_RT_HeapBlock
         precision = 0;
     }
 
-    char formatStr[FORMAT_FMTSTR_BUFFER_SIZE];
-    snprintf(
-        formatStr,
-        FORMAT_FMTSTR_BUFFER_SIZE,
-        "%%0%d%s%c",
-        precision,
-        GetPrintfLengthModifier(value->DataType()),
-        formatChar); // x or X should return different results
-
-    ret = DoPrintfOnDataType(buffer, formatStr, value);
+    // x or X should return different results
+    ret = FormatHex(buffer, value, precision, formatChar);
 
     if (ret > maxWidth)
     {
@@ -705,42 +863,28 @@ int Library_corlib_native_System_Number::Format_F(
 
     bool isIntegerDataType = IsIntegerDataType(dataType);
 
-    char formatStr[FORMAT_FMTSTR_BUFFER_SIZE];
-    snprintf(
-        formatStr,
-        FORMAT_FMTSTR_BUFFER_SIZE,
-        "%%0.%d%s%c",
-        precision,
-        (isIntegerDataType) ? GetPrintfLengthModifier(dataType) : "",
-        (!isIntegerDataType)                  ? 'f'
-        : (IsSignedIntegerDataType(dataType)) ? 'd'
-                                              : 'u');
-
-    ret = DoPrintfOnDataType(buffer, formatStr, value);
+    if (!isIntegerDataType)
+    {
+        char formatStr[FORMAT_FMTSTR_BUFFER_SIZE];
+        snprintf(formatStr, FORMAT_FMTSTR_BUFFER_SIZE, "%%0.%df", precision);
+
+        ret = DoPrintfOnDataType(buffer, formatStr, value);
+    }
+    else
+    {
+        ret = FormatInteger(buffer, value, 1);
+    }
 
     // this extra processing is only required for integer types
     if (isIntegerDataType && ret > 0)
     {
-        bool isNegative = (buffer[0] == '-');
-        int offsetBecauseOfNegativeSign = (isNegative ? 1 : 0);
-
-        int dotIndex = GetDotIndex(buffer, ret);
-
-        // if there is no dot, set the index to the end of the string
-        if (dotIndex == -1)
+        // keep room for the terminator
+        if (precision > FORMAT_RESULT_BUFFER_SIZE - ret - 2)
         {
-            dotIndex = ret;
+            precision = FORMAT_RESULT_BUFFER_SIZE - ret - 2;
         }
 
-        // strip trailing zeros
-        while (buffer[offsetBecauseOfNegativeSign] != '.' && buffer[offsetBecauseOfNegativeSign] == '0' && ret > 1)
-        {
-            memmove(&buffer[offsetBecauseOfNegativeSign], &buffer[offsetBecauseOfNegativeSign + 1], ret);
-
-            ret--;
-        };
-
-        if (isIntegerDataType && (precision > 0))
+        if (precision > 0)
         {
             // insert '.' and...
             buffer[ret++] = '.';
@@ -22,9 +22,27 @@ HRESULT Library_corlib_native_System_Object::GetHashCode___I4(CLR_RT_StackFrame
     NATIVE_PROFILE_CLR_CORE();
     NANOCLR_HEADER();
 
-    stack.SetResult_I4(CLR_RT_HeapBlock::GetHashCode(stack.This(), true, 0));
+    CLR_UINT32 hashCode;
 
-    NANOCLR_NOCLEANUP_NOLABEL();
+    while (true)
+    {
+        g_CLR_RT_ExecutionEngine.m_identityHashCodesMissed = 0;
+
+        hashCode = CLR_RT_HeapBlock::GetHashCode(stack.This(), true, 0);
+
+        if (g_CLR_RT_ExecutionEngine.m_identityHashCodesMissed == 0)
+        {
+            break;
+        }
+
+        // the object didn't get an identity, make room for it (this can compact the heap) and hash again
+        NANOCLR_CHECK_HRESULT(
+            g_CLR_RT_ExecutionEngine.IdentityHashCodes_Reserve(g_CLR_RT_ExecutionEngine.m_identityHashCodesMissed));
+    }
+
+    stack.SetResult_I4(hashCode);
+
+    NANOCLR_NOCLEANUP();
 }
 
 #if (NANOCLR_REFLECTION == TRUE)
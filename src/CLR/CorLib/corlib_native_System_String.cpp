@@ -12,6 +12,242 @@ static const CLR_UINT16 c_WhiteSpaces[] = {
 
 //--//
 
+// Helpers for strings that are all ASCII: character indexes are byte offsets so there's no need to walk the UTF-8
+// sequence or to convert the string to a char array.
+
+// bitmap with the ASCII characters of a char set, the others can't be found in an ASCII string
+struct AsciiCharSet
+{
+    CLR_UINT32 m_bits[4];
+
+    void Initialize(const CLR_UINT16 *chars, CLR_UINT32 count)
+    {
+        m_bits[0] = m_bits[1] = m_bits[2] = m_bits[3] = 0;
+
+        while (count-- > 0)
+        {
+            CLR_UINT16 c = *chars++;
+
+            if (c < 0x80)
+            {
+                m_bits[c >> 5] |= 1u << (c & 0x1F);
+            }
+        }
+    }
+
+    bool Contains(CLR_UINT8 c) const
+    {
+        return c < 0x80 && (m_bits[c >> 5] & (1u << (c & 0x1F))) != 0;
+    }
+};
+
+static bool IsAsciiString(const CLR_RT_HeapBlock &ref)
+{
+    CLR_RT_HeapBlock_String *str = ref.DereferenceString();
+
+    return str != NULL && str->IsAscii();
+}
+
+// Horspool search of szSearch in szText, starting at startIndex and up to lastIndex (inclusive)
+static int SearchAsciiForward(const char *szText, const char *szSearch, int searchLen, int startIndex, int lastIndex)
+{
+    const CLR_UINT8 *text = (const CLR_UINT8 *)szText;
+    const CLR_UINT8 *search = (const CLR_UINT8 *)szSearch;
+    CLR_UINT8 skip[256];
+    int maxSkip = searchLen < 255 ? searchLen : 255;
+    int pos = startIndex;
+
+    if (searchLen < 3)
+    {
+        // short needle: find the first char and check the remaining one
+        while (pos <= lastIndex)
+        {
+            const CLR_UINT8 *found = (const CLR_UINT8 *)memchr(&text[pos], search[0], lastIndex - pos + 1);
+
+            if (found == NULL)
+            {
+                break;
+            }
+
+            pos = (int)(found - text);
+
+            if (searchLen == 1 || text[pos + 1] == search[1])
+            {
+                return pos;
+            }
+
+            pos++;
+        }
+
+        return -1;
+    }
+
+    memset(skip, maxSkip, sizeof(skip));
+
+    for (int i = 0; i < searchLen - 1; i++)
+    {
+        int shift = searchLen - 1 - i;
+
+        skip[search[i]] = (CLR_UINT8)(shift < 255 ? shift : 255);
+    }
+
+    while (pos <= lastIndex)
+    {
+        CLR_UINT8 c = text[pos + searchLen - 1];
+
+        if (c == search[searchLen - 1] && memcmp(&text[pos], search, searchLen - 1) == 0)
+        {
+            return pos;
+        }
+
+        pos += skip[c];
+    }
+
+    return -1;
+}
+
+static int IndexOfAscii(
+    const char *szText,
+    int inputLen,
+    const char *szSearch,
+    int searchLen,
+    const CLR_UINT16 *pChars,
+    int iChars,
+    int startIndex,
+    int count,
+    bool fLast)
+{
+    if (count <= 0)
+    {
+        return -1;
+    }
+
+    if (szSearch)
+    {
+        if (fLast)
+        {
+            for (int pos = startIndex; count-- > 0 && pos >= 0; pos--)
+            {
+                // search string goes past the end of the input, the search is over
+                if (pos + searchLen > inputLen)
+                {
+                    return -1;
+                }
+
+                if (memcmp(&szText[pos], szSearch, searchLen) == 0)
+                {
+                    return pos;
+                }
+            }
+
+            return -1;
+        }
+
+        if (searchLen == 0)
+        {
+            return startIndex;
+        }
+
+        int lastIndex = startIndex + count - 1;
+
+        if (lastIndex > inputLen - searchLen)
+        {
+            lastIndex = inputLen - searchLen;
+        }
+
+        return SearchAsciiForward(szText, szSearch, searchLen, startIndex, lastIndex);
+    }
+
+    if (iChars == 1 && !fLast)
+    {
+        const char *found;
+
+        if (pChars[0] >= 0x80)
+        {
+            return -1;
+        }
+
+        found = (const char *)memchr(&szText[startIndex], pChars[0], count);
+
+        return found ? (int)(found - szText) : -1;
+    }
+
+    AsciiCharSet charSet;
+    charSet.Initialize(pChars, iChars);
+
+    if (fLast)
+    {
+        for (int pos = startIndex; count-- > 0 && pos >= 0; pos--)
+        {
+            if (pos >= inputLen)
+            {
+                return -1;
+            }
+
+            if (charSet.Contains((CLR_UINT8)szText[pos]))
+            {
+                return pos;
+            }
+        }
+    }
+    else
+    {
+        for (int pos = startIndex; count-- > 0 && pos < inputLen; pos++)
+        {
+            if (charSet.Contains((CLR_UINT8)szText[pos]))
+            {
+                return pos;
+            }
+        }
+    }
+
+    return -1;
+}
+
+static HRESULT TrimAscii(CLR_RT_StackFrame &stack, const CLR_UINT16 *pTrim, CLR_UINT32 iTrim, bool fStart, bool fEnd)
+{
+    NATIVE_PROFILE_CLR_CORE();
+    NANOCLR_HEADER();
+
+    CLR_RT_HeapBlock_String *str = stack.Arg0().DereferenceString();
+    const char *szStart = str->StringText();
+    const char *szEnd = szStart + str->GetLength();
+    AsciiCharSet charSet;
+
+    charSet.Initialize(pTrim, iTrim);
+
+    if (fStart)
+    {
+        while (szStart < szEnd && charSet.Contains((CLR_UINT8)szStart[0]))
+        {
+            szStart++;
+        }
+    }
+
+    if (fEnd)
+    {
+        while (szStart < szEnd && charSet.Contains((CLR_UINT8)szEnd[-1]))
+        {
+            szEnd--;
+        }
+    }
+
+    // nothing to trim, strings are immutable so the same instance can be returned
+    if (szStart == str->StringText() && szEnd == szStart + str->GetLength())
+    {
+        stack.PushValue().SetObjectReference(str);
+    }
+    else
+    {
+        NANOCLR_CHECK_HRESULT(
+            CLR_RT_HeapBlock_String::CreateInstance(stack.PushValue(), szStart, (CLR_UINT32)(szEnd - szStart)));
+    }
+
+    NANOCLR_NOCLEANUP();
+}
+
+//--//
+
 HRESULT Library_corlib_native_System_String::CompareTo___I4__OBJECT(CLR_RT_StackFrame &stack)
 {
     NATIVE_PROFILE_CLR_CORE();
@@ -27,6 +263,7 @@ HRESULT Library_corlib_native_System_String::get_Chars___CHAR__I4(CLR_RT_StackFr
     NATIVE_PROFILE_CLR_CORE();
     NANOCLR_HEADER();
 
+    CLR_RT_HeapBlock_String *str;
     const char *szText;
     CLR_RT_UnicodeHelper uh;
     CLR_UINT16 buf[3];
@@ -36,15 +273,25 @@ HRESULT Library_corlib_native_System_String::get_Chars___CHAR__I4(CLR_RT_StackFr
     szText = stack.Arg0().RecoverString();
     FAULT_ON_NULL(szText);
 
-    uh.SetInputUTF8(szText);
+    str = stack.Arg0().DereferenceString();
 
-    len = uh.CountNumberOfCharacters();
+    len = str->GetLength();
     if (len < 0)
         NANOCLR_SET_AND_LEAVE(CLR_E_WRONG_TYPE);
     index = stack.Arg1().NumericByRef().s4;
     if (index < 0 || index >= len)
         NANOCLR_SET_AND_LEAVE(CLR_E_OUT_OF_RANGE);
 
+    // ASCII strings have one byte per character, no need to walk the UTF-8 sequence
+    if (str->IsAscii())
+    {
+        stack.SetResult((CLR_UINT8)szText[index], DATATYPE_CHAR);
+
+        NANOCLR_SET_AND_LEAVE(S_OK);
+    }
+
+    uh.SetInputUTF8(szText);
+
     uh.m_outputUTF16 = buf;
     uh.m_outputUTF16_size = MAXSTRLEN(buf);
 
@@ -87,10 +334,7 @@ HRESULT Library_corlib_native_System_String::get_Length___I4(CLR_RT_StackFrame &
     const char *szText = stack.Arg0().RecoverString();
     FAULT_ON_NULL(szText);
 
-    CLR_RT_UnicodeHelper uh;
-    uh.SetInputUTF8(szText);
-
-    stack.SetResult_I4(uh.CountNumberOfCharacters());
+    stack.SetResult_I4(stack.Arg0().DereferenceString()->GetLength());
 
     NANOCLR_NOCLEANUP();
 }
@@ -598,8 +842,10 @@ HRESULT Library_corlib_native_System_String::IndexOf(CLR_RT_StackFrame &stack, i
     const CLR_UINT16 *pChars;
     int iChars = 0;
     CLR_RT_UnicodeHelper inputIterator;
+    CLR_RT_HeapBlock_String *input;
     int inputLen;
     int searchLen = 1;
+    bool fAscii = true;
 
     szText = stack.Arg0().RecoverString();
     if (!szText)
@@ -623,16 +869,19 @@ HRESULT Library_corlib_native_System_String::IndexOf(CLR_RT_StackFrame &stack, i
     }
     else if (mode & c_IndexOf__String)
     {
-        pString = stack.Arg1().RecoverString();
-        FAULT_ON_NULL(pString);
+        CLR_RT_HeapBlock_String *search = stack.Arg1().DereferenceString();
+        FAULT_ON_NULL(search);
+
+        pString = search->StringText();
         // how long is the search string?
-        inputIterator.SetInputUTF8(pString);
-        searchLen = inputIterator.CountNumberOfCharacters();
+        searchLen = search->GetLength();
+        fAscii = search->IsAscii();
     }
 
     // calculate input string length
-    inputIterator.SetInputUTF8(szText);
-    inputLen = inputIterator.CountNumberOfCharacters();
+    input = stack.Arg0().DereferenceString();
+    inputLen = input ? input->GetLength() : 0;
+    fAscii = fAscii && input && input->IsAscii();
 
     if (0 == inputLen)
     {
@@ -714,6 +963,25 @@ HRESULT Library_corlib_native_System_String::IndexOf(CLR_RT_StackFrame &stack, i
             NANOCLR_SET_AND_LEAVE(CLR_E_OUT_OF_RANGE);
     }
 
+    // ASCII input (and search string) can be searched byte by byte
+    if (fAscii)
+    {
+        pos = IndexOfAscii(
+            szText,
+            inputLen,
+            pString,
+            searchLen,
+            pChars,
+            iChars,
+            startIndex,
+            count,
+            (mode & c_IndexOf__Last) != 0);
+
+        goto Exit;
+    }
+
+    inputIterator.SetInputUTF8(szText);
+
     // First move to the character, then read it.
     if (inputIterator.ConvertFromUTF8(startIndex, true))
     {
@@ -946,14 +1214,6 @@ HRESULT Library_corlib_native_System_String::Trim(
     CLR_RT_HeapBlock refTmp;
     CLR_RT_HeapBlock_Array *arrayTmp;
 
-    refTmp.SetObjectReference(NULL);
-    CLR_RT_ProtectFromGC gc(refTmp);
-
-    NANOCLR_CHECK_HRESULT(ConvertToCharArray(stack, refTmp, arrayTmp, 0, -1));
-
-    pSrcStart = (CLR_UINT16 *)arrayTmp->GetFirstElement();
-    pSrcEnd = &pSrcStart[arrayTmp->m_numOfElements];
-
     const CLR_UINT16 *pTrim;
     CLR_UINT32 iTrim;
 
@@ -968,6 +1228,19 @@ HRESULT Library_corlib_native_System_String::Trim(
         iTrim = ARRAYSIZE(c_WhiteSpaces);
     }
 
+    refTmp.SetObjectReference(NULL);
+    CLR_RT_ProtectFromGC gc(refTmp);
+
+    if (IsAsciiString(stack.Arg0()))
+    {
+        NANOCLR_SET_AND_LEAVE(TrimAscii(stack, pTrim, iTrim, fStart, fEnd));
+    }
+
+    NANOCLR_CHECK_HRESULT(ConvertToCharArray(stack, refTmp, arrayTmp, 0, -1));
+
+    pSrcStart = (CLR_UINT16 *)arrayTmp->GetFirstElement();
+    pSrcEnd = &pSrcStart[arrayTmp->m_numOfElements];
+
     //--//
 
     if (fStart)
@@ -1056,6 +1329,53 @@ HRESULT Library_corlib_native_System_String::Split(CLR_RT_StackFrame &stack, CLR
 
         arrayDst = NULL;
 
+        if (IsAsciiString(stack.Arg0()))
+        {
+            CLR_RT_HeapBlock_String *strSrc = stack.Arg0().DereferenceString();
+            CLR_UINT32 lengthSrc = (CLR_UINT32)strSrc->GetLength();
+            AsciiCharSet charSet;
+
+            charSet.Initialize(pChars, cChars);
+
+            for (int pass = 0; pass < 2; pass++)
+            {
+                // the source string is an object on the heap, no compaction happens while allocating here
+                const char *szSrcStart = strSrc->StringText();
+                const char *szSrc = szSrcStart;
+                int count = 0;
+
+                for (CLR_UINT32 iSrc = 0; iSrc <= lengthSrc; iSrc++, szSrc++)
+                {
+                    if (iSrc < lengthSrc && ((count + 1) >= maxStrings || !charSet.Contains((CLR_UINT8)szSrc[0])))
+                    {
+                        continue;
+                    }
+
+                    if (pass == 1)
+                    {
+                        CLR_RT_HeapBlock *str = (CLR_RT_HeapBlock *)arrayDst->GetElement(count);
+
+                        NANOCLR_CHECK_HRESULT(
+                            CLR_RT_HeapBlock_String::CreateInstance(*str, szSrcStart, (CLR_UINT32)(szSrc - szSrcStart)));
+
+                        szSrcStart = szSrc + 1;
+                    }
+
+                    count++;
+                }
+
+                if (pass == 0)
+                {
+                    CLR_RT_HeapBlock &refTarget = stack.PushValue();
+
+                    NANOCLR_CHECK_HRESULT(
+                        CLR_RT_HeapBlock_Array::CreateInstance(refTarget, count, g_CLR_RT_WellKnownTypes.m_String));
+
+                    arrayDst = refTarget.DereferenceArray();
+                }
+            }
+        }
+        else
         {
             CLR_RT_HeapBlock refSrc;
 
@@ -1138,55 +1458,8 @@ HRESULT Library_corlib_native_System_String::Concat(CLR_RT_StackFrame &stack, CL
     NATIVE_PROFILE_CLR_CORE();
     NANOCLR_HEADER();
 
-    CLR_RT_HeapBlock *ptrSrc;
-    const char *szTextSrc;
-    char *szTextDst = NULL;
-    CLR_UINT32 totLen;
-    CLR_UINT32 len;
-
-    totLen = 0;
-
-    for (int i = 0; i < 2; i++)
-    {
-        ptrSrc = array;
-
-        for (int iStr = 0; iStr < num; iStr++)
-        {
-            if (ptrSrc->Dereference() != NULL && ptrSrc->Dereference()->DataType() == DATATYPE_STRING)
-            {
-                szTextSrc = ptrSrc->RecoverString();
-
-                if (szTextSrc)
-                {
-                    len = (CLR_UINT32)hal_strlen_s(szTextSrc);
-
-                    if (i == 0)
-                    {
-                        totLen += len;
-                    }
-                    else
-                    {
-                        memcpy(szTextDst, szTextSrc, len);
-
-                        szTextDst += len;
-                    }
-                }
-            }
-
-            ptrSrc++;
-        }
-
-        if (i == 0)
-        {
-            // push return value
-            CLR_RT_HeapBlock &blkResult = stack.PushValue();
-            CLR_RT_HeapBlock_String *str = CLR_RT_HeapBlock_String::CreateInstance(blkResult, totLen);
-            CHECK_ALLOCATION(str);
-
-            szTextDst = (char *)str->StringText();
-            szTextDst[totLen] = 0;
-        }
-    }
+    // push return value
+    NANOCLR_SET_AND_LEAVE(CLR_RT_HeapBlock_String::CreateConcatenation(stack.PushValue(), array, num));
 
     NANOCLR_NOCLEANUP();
 }
@@ -1242,5 +1515,38 @@ HRESULT Library_corlib_native_System_String::ConvertToCharArray(
     int length)
 {
     NATIVE_PROFILE_CLR_CORE();
-    return ConvertToCharArray(stack.Arg0().RecoverString(), ref, array, startIndex, length);
+    NANOCLR_HEADER();
+
+    CLR_RT_HeapBlock_String *str = stack.Arg0().DereferenceString();
+    const CLR_UINT8 *src;
+    CLR_UINT16 *dst;
+    int totLength;
+
+    // ASCII text maps one byte to one char, there is no need to go through the UTF-8 decoder
+    if (str == NULL || str->StringText() == NULL || str->IsAscii() == false)
+    {
+        NANOCLR_SET_AND_LEAVE(ConvertToCharArray(stack.Arg0().RecoverString(), ref, array, startIndex, length));
+    }
+
+    totLength = str->GetLength();
+
+    if (length == -1)
+        length = totLength;
+
+    if (CLR_RT_HeapBlock_Array::CheckRange(startIndex, length, totLength) == false)
+        NANOCLR_SET_AND_LEAVE(CLR_E_OUT_OF_RANGE);
+
+    NANOCLR_CHECK_HRESULT(CLR_RT_HeapBlock_Array::CreateInstance(ref, length, g_CLR_RT_WellKnownTypes.m_Char));
+
+    array = ref.DereferenceArray();
+
+    src = (const CLR_UINT8 *)str->StringText() + startIndex;
+    dst = (CLR_UINT16 *)array->GetFirstElement();
+
+    for (int i = 0; i < length; i++)
+    {
+        dst[i] = src[i];
+    }
+
+    NANOCLR_NOCLEANUP();
 }
@@ -231,6 +231,15 @@ HRESULT Library_corlib_native_System_Threading_Thread::set_Priority___VOID__Syst
             // Priority of current sub-thread is set the thread priority.
             th->SetThreadPriority(pri);
 
+            // Join or leave the real-time scheduling class if the target maps ThreadPriority.Highest to it.
+            g_CLR_RT_ExecutionEngine.UpdateSchedulingClass(th);
+
+            // Move a ready thread to the ready band of its new priority.
+            if (th->m_status == CLR_RT_Thread::TH_S_Ready)
+            {
+                g_CLR_RT_ExecutionEngine.PutInProperList(th);
+            }
+
             stack.m_customState = 1;
 
             // If we set high priority to another thread, then we need to swtich to another thread.
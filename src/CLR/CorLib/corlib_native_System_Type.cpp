@@ -406,12 +406,30 @@ HRESULT Library_corlib_native_System_Type::GetFields(
     CLR_RT_TypeDef_Instance tdArg;
     int iField;
     CLR_RT_HeapBlock *hbType = stack.Arg0().Dereference();
+    bool fCacheable;
+    CLR_UINT32 lookupFlags;
+    CLR_UINT32 member;
 
     if (bindingFlags == c_BindingFlags_Default)
         bindingFlags = c_BindingFlags_DefaultLookup;
 
     NANOCLR_CHECK_HRESULT(Library_corlib_native_System_RuntimeType::GetTypeDescriptor(*hbType, tdArg));
 
+    // a single field looked up by its exact name goes through the lookup cache
+    fCacheable = !fAllMatches && szText != NULL && (bindingFlags & c_BindingFlags_IgnoreCase) == 0;
+    lookupFlags = bindingFlags | CLR_RT_ExecutionEngine::c_ReflectionLookup_Field;
+
+    if (fCacheable && g_CLR_RT_ExecutionEngine.ReflectionLookup_Find(tdArg, szText, lookupFlags, member))
+    {
+        CLR_RT_FieldDef_Index idx;
+        idx.m_data = member;
+
+        NANOCLR_SET_AND_LEAVE(g_CLR_RT_ExecutionEngine.GetReflectionObject(
+            stack.PushValueAndClear(),
+            g_CLR_RT_WellKnownTypes.m_FieldInfo,
+            idx));
+    }
+
     {
         CLR_RT_HeapBlock &top = stack.PushValueAndClear();
 
@@ -479,22 +497,24 @@ HRESULT Library_corlib_native_System_Type::GetFields(
 
                     if (!fAllMatches)
                     {
-                        CLR_RT_HeapBlock *hbObj;
-                        NANOCLR_CHECK_HRESULT(
-                            g_CLR_RT_ExecutionEngine.NewObjectFromIndex(top, g_CLR_RT_WellKnownTypes.m_FieldInfo));
-                        hbObj = top.Dereference();
-                        hbObj->SetReflection(idx);
+                        if (fCacheable)
+                        {
+                            g_CLR_RT_ExecutionEngine.ReflectionLookup_Add(tdArg, szText, lookupFlags, idx.m_data);
+                        }
 
-                        NANOCLR_SET_AND_LEAVE(S_OK);
+                        NANOCLR_SET_AND_LEAVE(g_CLR_RT_ExecutionEngine.GetReflectionObject(
+                            top,
+                            g_CLR_RT_WellKnownTypes.m_FieldInfo,
+                            idx));
                     }
                     else if (pass == 1)
                     {
                         CLR_RT_HeapBlock *elem = (CLR_RT_HeapBlock *)top.DereferenceArray()->GetElement(iField);
-                        CLR_RT_HeapBlock *hbObj;
-                        NANOCLR_CHECK_HRESULT(
-                            g_CLR_RT_ExecutionEngine.NewObjectFromIndex(*elem, g_CLR_RT_WellKnownTypes.m_FieldInfo));
-                        hbObj = elem->Dereference();
-                        NANOCLR_CHECK_HRESULT(hbObj->SetReflection(idx));
+
+                        NANOCLR_CHECK_HRESULT(g_CLR_RT_ExecutionEngine.GetReflectionObject(
+                            *elem,
+                            g_CLR_RT_WellKnownTypes.m_FieldInfo,
+                            idx));
                     }
 
                     iField++;
@@ -537,12 +557,20 @@ HRESULT Library_corlib_native_System_Type::GetMethods(
     CLR_RT_HeapBlock &top = stack.PushValueAndClear();
     CLR_RT_HeapBlock *hbType = stack.Arg0().Dereference();
     bool staticInstanceOnly = false;
+    bool fCacheable;
+    CLR_UINT32 lookupFlags;
+    CLR_UINT32 member;
 
     if (bindingFlags == c_BindingFlags_Default)
     {
         bindingFlags = c_BindingFlags_DefaultLookup;
     }
 
+    // a single method looked up by name only goes through the lookup cache
+    // (bindingFlags changes while walking the hierarchy, keep the value the lookup started with)
+    fCacheable = !fAllMatches && szText != NULL && pParams == NULL;
+    lookupFlags = bindingFlags;
+
     // in default lookup mode we want the static methods only from the instance not from the base classes
     if (bindingFlags == c_BindingFlags_DefaultLookup)
     {
@@ -551,6 +579,24 @@ HRESULT Library_corlib_native_System_Type::GetMethods(
 
     NANOCLR_CHECK_HRESULT(Library_corlib_native_System_RuntimeType::GetTypeDescriptor(*hbType, tdArg));
 
+    if (fCacheable && g_CLR_RT_ExecutionEngine.ReflectionLookup_Find(tdArg, szText, lookupFlags, member))
+    {
+        CLR_RT_MethodDef_Index idx;
+        CLR_RT_HeapBlock *hbObj;
+
+        idx.m_data = member;
+        inst.InitializeFromIndex(idx);
+
+        NANOCLR_CHECK_HRESULT(g_CLR_RT_ExecutionEngine.NewObjectFromIndex(top, g_CLR_RT_WellKnownTypes.m_MethodInfo));
+        hbObj = top.Dereference();
+        hbObj->SetReflection(inst);
+
+        // store token for type
+        hbObj[Library_corlib_native_System_Reflection_MethodBase::FIELD___token].NumericByRef().u4 = inst.m_data;
+
+        NANOCLR_SET_AND_LEAVE(S_OK);
+    }
+
     for (int pass = 0; pass < 2; pass++)
     {
         td = tdArg;
@@ -781,6 +827,12 @@ HRESULT Library_corlib_native_System_Type::GetMethods(
         {
             if (!fAllMatches)
             {
+                // only a lookup that went through without ambiguity gets here
+                if (fCacheable && NANOCLR_INDEX_IS_VALID(inst))
+                {
+                    g_CLR_RT_ExecutionEngine.ReflectionLookup_Add(tdArg, szText, lookupFlags, inst.m_data);
+                }
+
                 NANOCLR_SET_AND_LEAVE(S_OK);
             }
 
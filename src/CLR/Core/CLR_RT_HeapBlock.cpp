@@ -1064,8 +1064,10 @@ CLR_UINT32 CLR_RT_HeapBlock::GetHashCode(CLR_RT_HeapBlock *ptr, bool fRecurse, C
 
         case DATATYPE_STRING:
         {
-            const char *src = ptr->StringText();
-            crc ^= SUPPORT_ComputeCRC(src, (int)hal_strlen_s(src), crc);
+            // the hash of the text is cached in the string, the running value is folded in so that the position of
+            // a string field still counts when hashing a value type
+            CLR_UINT32 hash = ((CLR_RT_HeapBlock_String *)ptr)->GetTextHashCode();
+            crc ^= (crc * 0x9E3779B1) ^ hash;
         }
         break;
 
@@ -1161,30 +1163,35 @@ CLR_UINT32 CLR_RT_HeapBlock::GetHashCode(CLR_RT_HeapBlock *ptr, bool fRecurse, C
             // DATATYPE_I8
             // DATATYPE_U8
             // DATATYPE_R8
-            if (fRecurse && cls.m_target->dataType <= DATATYPE_R8)
+            if (cls.m_target->dataType <= DATATYPE_R8)
             {
                 // pass the 1st field which is the one holding the actual value
                 crc ^= GetHashCode(&ptr[CLR_RT_HeapBlock::HB_Object_Fields_Offset], false, crc);
             }
-            else
+            else if (fRecurse)
             {
-                // always starts with the pointer to the object to fully disambiguate
-                crc ^= SUPPORT_ComputeCRC(&ptr, sizeof(ptr), crc);
+                // always starts with the identity of the object to fully disambiguate
+                // (not its address, which changes when the heap is compacted)
+                CLR_UINT32 identity = g_CLR_RT_ExecutionEngine.GetIdentityHashCode(ptr);
+                crc ^= SUPPORT_ComputeCRC(&identity, sizeof(identity), crc);
 
-                if (fRecurse)
-                {
-                    int totFields = cls.CrossReference().m_totalFields;
+                // the fields are hashed by value only: objects they reference are not followed,
+                // so only the object the hash code is asked for takes an entry in the identity table
+                int totFields = cls.CrossReference().m_totalFields;
 
-                    if (totFields > 0)
+                if (totFields > 0)
+                {
+                    do
                     {
-                        do
-                        {
-                            crc ^=
-                                GetHashCode(&ptr[--totFields + CLR_RT_HeapBlock::HB_Object_Fields_Offset], true, crc);
-                        } while (totFields > 0);
-                    }
+                        crc ^= GetHashCode(&ptr[--totFields + CLR_RT_HeapBlock::HB_Object_Fields_Offset], false, crc);
+                    } while (totFields > 0);
                 }
             }
+            else
+            {
+                // an object reached through a field or a delegate only contributes its type
+                crc ^= SUPPORT_ComputeCRC(&ptr->ObjectCls(), sizeof(CLR_RT_TypeDef_Index), crc);
+            }
         }
         break;
 
@@ -146,17 +146,30 @@ HRESULT CLR_RT_HeapBlock_Array::ClearElements(int index, int length)
                 break;
         }
 
-        while (length > 0)
+        CLR_UINT32 dataId = CLR_RT_HEAPBLOCK_RAW_ID(dt, 0, 1);
+
+        if (!fAllocate)
         {
-            ptr->SetDataId(CLR_RT_HEAPBLOCK_RAW_ID(dt, 0, 1));
+            // plain references: only the header has to be stamped on the zeroed blocks
+            while (length > 0)
+            {
+                ptr->SetDataId(dataId);
 
-            if (fAllocate)
+                ptr++;
+                length--;
+            }
+        }
+        else
+        {
+            while (length > 0)
             {
+                ptr->SetDataId(dataId);
+
                 NANOCLR_CHECK_HRESULT(g_CLR_RT_ExecutionEngine.NewObjectFromIndex(*ptr, reflex.m_data.m_type));
-            }
 
-            ptr++;
-            length--;
+                ptr++;
+                length--;
+            }
         }
     }
 
@@ -188,6 +201,54 @@ bool CLR_RT_HeapBlock_Array::CheckRange(int index, int length, int numOfElements
     return true;
 }
 
+//--//
+
+// Search kernels for primitive arrays. Elements are compared bitwise, same as memcmp on the raw
+// storage, but the match value is loaded once and each element is read with its natural width.
+
+template <typename T> static int IndexOfPrimitive(const CLR_UINT8 *data, const void *match, int count, bool fForward)
+{
+    const T *ptr = (const T *)data;
+    T value;
+
+    memcpy(&value, match, sizeof(T));
+
+    if (fForward)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            if (ptr[i] == value)
+            {
+                return i;
+            }
+        }
+    }
+    else
+    {
+        for (int i = count - 1; i >= 0; i--)
+        {
+            if (ptr[i] == value)
+            {
+                return i;
+            }
+        }
+    }
+
+    return -1;
+}
+
+static int IndexOfPrimitive8(const CLR_UINT8 *data, const void *match, int count, bool fForward)
+{
+    if (fForward)
+    {
+        const CLR_UINT8 *found = (const CLR_UINT8 *)memchr(data, *(const CLR_UINT8 *)match, count);
+
+        return found ? (int)(found - data) : -1;
+    }
+
+    return IndexOfPrimitive<CLR_UINT8>(data, match, count, false);
+}
+
 /*
     This is not the same functionality as System.Array.IndexOf.  CLR_RT_HeapBlock_Array::IndexOf does the search
    analogous to calling Object.ReferenceEquals, not Object.Equals, as System.Array.IndexOf demands.  This function is
@@ -233,8 +294,6 @@ HRESULT CLR_RT_HeapBlock_Array::IndexOf(
             incr = -1;
         }
 
-        data += pos * sizeElem;
-
         if (!array->m_fReference)
         {
             CLR_RT_HeapBlock *matchPtr = match.FixBoxingReference();
@@ -242,26 +301,55 @@ HRESULT CLR_RT_HeapBlock_Array::IndexOf(
 
             if (matchPtr->DataType() <= DATATYPE_LAST_PRIMITIVE)
             {
-                int incrElem = incr * sizeElem;
+                const CLR_UINT8 *range = data + start * sizeElem;
+                const void *value = &matchPtr->NumericByRef();
+                int found;
 
-                while (true)
+                switch (sizeElem)
                 {
-                    if (memcmp(data, &matchPtr->NumericByRef(), sizeElem) == 0)
-                    {
-                        index = pos;
-                        NANOCLR_SET_AND_LEAVE(S_OK);
-                    }
+                    case 1:
+                        found = IndexOfPrimitive8(range, value, count, fForward);
+                        break;
 
-                    if (--count == 0)
+                    case 2:
+                        found = IndexOfPrimitive<CLR_UINT16>(range, value, count, fForward);
                         break;
 
-                    pos += incr;
-                    data += incrElem;
+                    case 4:
+                        found = IndexOfPrimitive<CLR_UINT32>(range, value, count, fForward);
+                        break;
+
+                    case 8:
+                        found = IndexOfPrimitive<CLR_UINT64>(range, value, count, fForward);
+                        break;
+
+                    default:
+                        found = -1;
+
+                        for (int i = 0; i < count; i++)
+                        {
+                            int elem = fForward ? i : count - 1 - i;
+
+                            if (memcmp(range + elem * sizeElem, value, sizeElem) == 0)
+                            {
+                                found = elem;
+                                break;
+                            }
+                        }
+                        break;
+                }
+
+                if (found >= 0)
+                {
+                    index = start + found;
+                    NANOCLR_SET_AND_LEAVE(S_OK);
                 }
             }
         }
         else
         {
+            data += pos * sizeElem;
+
             CLR_RT_HeapBlock *dataPtr = (CLR_RT_HeapBlock *)data;
 
             while (true)
@@ -342,10 +430,21 @@ HRESULT CLR_RT_HeapBlock_Array::Copy(
             }
             else
             {
+                const CLR_RT_ReflectionDef_Index &reflex = arraySrc->ReflectionDataConst();
                 CLR_RT_HeapBlock *ptrSrc = (CLR_RT_HeapBlock *)dataSrc;
                 CLR_RT_HeapBlock *ptrDst = (CLR_RT_HeapBlock *)dataDst;
                 int incr;
 
+                if (!(reflex.m_levels == 1 && arraySrc->m_typeOfElement == DATATYPE_VALUETYPE))
+                {
+                    // Same element type and no unboxed value types in the slots: Reassign boils down to a
+                    // plain block copy for every element, so move the whole range at once.
+                    // The type check was already done by SameHeader.
+                    memmove(dataDst, dataSrc, length * sizeElem);
+
+                    NANOCLR_SET_AND_LEAVE(S_OK);
+                }
+
                 if (arraySrc == arrayDst && ptrSrc < ptrDst)
                 {
                     incr = -1;
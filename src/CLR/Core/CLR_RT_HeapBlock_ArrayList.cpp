@@ -106,13 +106,10 @@ HRESULT CLR_RT_HeapBlock_ArrayList::Insert(CLR_INT32 index, CLR_RT_HeapBlock *va
     if (index < size)
     {
         // Move everything up one slot.
-        CLR_RT_HeapBlock *current = (CLR_RT_HeapBlock *)items->GetElement(size);
-        CLR_RT_HeapBlock *end = (CLR_RT_HeapBlock *)items->GetElement(index);
-
-        do
-        {
-            current->Assign(*(current - 1));
-        } while (--current != end);
+        memmove(
+            items->GetElement(index + 1),
+            items->GetElement(index),
+            (size - index) * sizeof(struct CLR_RT_HeapBlock));
     }
 
     ((CLR_RT_HeapBlock *)items->GetElement(index))->SetObjectReference(value);
@@ -137,13 +134,10 @@ HRESULT CLR_RT_HeapBlock_ArrayList::RemoveAt(CLR_INT32 index)
     if (index < size - 1)
     {
         // Move everything down one slot.
-        CLR_RT_HeapBlock *current = (CLR_RT_HeapBlock *)items->GetElement(index);
-        CLR_RT_HeapBlock *end = (CLR_RT_HeapBlock *)items->GetElement(size - 1);
-
-        do
-        {
-            current->Assign(*(current + 1));
-        } while (++current != end);
+        memmove(
+            items->GetElement(index),
+            items->GetElement(index + 1),
+            (size - 1 - index) * sizeof(struct CLR_RT_HeapBlock));
     }
 
     size--;
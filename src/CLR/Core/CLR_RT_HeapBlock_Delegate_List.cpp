@@ -65,11 +65,14 @@ HRESULT CLR_RT_HeapBlock_Delegate_List::Change(
 
     CLR_RT_HeapBlock_Delegate_List *dlgListSrc;
     CLR_RT_HeapBlock_Delegate_List *dlgListDst;
+    CLR_RT_HeapBlock_Delegate_List *dlgListAdd = NULL;
     CLR_RT_HeapBlock_Delegate *dlg;
     CLR_RT_HeapBlock *newDlgs;
     CLR_RT_HeapBlock *oldDlgs;
+    CLR_RT_HeapBlock *addDlgs = &delegateTarget;
     CLR_UINT32 oldNum;
     CLR_UINT32 newNum;
+    CLR_UINT32 addNum = 1;
 
     CLR_UINT32 num = 0;
 
@@ -88,7 +91,7 @@ HRESULT CLR_RT_HeapBlock_Delegate_List::Change(
         NANOCLR_SET_AND_LEAVE(S_OK);
     }
 
-    if (dlg->DataType() == DATATYPE_DELEGATELIST_HEAD)
+    if (dlg->DataType() == DATATYPE_DELEGATELIST_HEAD && fCombine == false)
     {
         CLR_RT_HeapBlock intermediate;
 
@@ -138,7 +141,41 @@ HRESULT CLR_RT_HeapBlock_Delegate_List::Change(
 
         if (fCombine)
         {
-            if (oldNum == 0 && fWeak == false)
+            if (dlg->DataType() == DATATYPE_DELEGATELIST_HEAD)
+            {
+                //
+                // Appending a whole list: build the result in one go, rather than one intermediate list per delegate.
+                //
+                CLR_RT_HeapBlock *lastAlive = NULL;
+                CLR_UINT32 numAlive = 0;
+
+                dlgListAdd = (CLR_RT_HeapBlock_Delegate_List *)dlg;
+                addDlgs = dlgListAdd->GetDelegates();
+                addNum = dlgListAdd->m_length;
+
+                for (num = 0; num < addNum; num++)
+                {
+                    if (addDlgs[num].DataType() == DATATYPE_OBJECT &&
+                        addDlgs[num].DereferenceDelegate() != NULL) // The delegate could have been GC'ed.
+                    {
+                        lastAlive = &addDlgs[num];
+                        numAlive++;
+                    }
+                }
+
+                if (numAlive == 0)
+                {
+                    reference.Assign(delegateSrc); // Nothing to add.
+                    NANOCLR_SET_AND_LEAVE(S_OK);
+                }
+
+                if (oldNum == 0 && fWeak == false && numAlive == 1)
+                {
+                    reference.Assign(*lastAlive);
+                    NANOCLR_SET_AND_LEAVE(S_OK);
+                }
+            }
+            else if (oldNum == 0 && fWeak == false)
             {
                 //
                 // Empty input list, copy the delegate.
@@ -149,7 +186,8 @@ HRESULT CLR_RT_HeapBlock_Delegate_List::Change(
 
             //--//
 
-            newNum = oldNum + 1;
+            // dead delegates are dropped by CopyAndCompress, which shortens the list accordingly
+            newNum = oldNum + addNum;
         }
         else
         {
@@ -191,15 +229,14 @@ HRESULT CLR_RT_HeapBlock_Delegate_List::Change(
 
         NANOCLR_CHECK_HRESULT(CLR_RT_HeapBlock_Delegate_List::CreateInstance(dlgListDst, newNum));
 
-        dlgListDst->m_cls = dlg->m_cls;
+        dlgListDst->m_cls = dlgListAdd ? dlgListAdd->m_cls : dlg->m_cls;
 
         newDlgs = dlgListDst->GetDelegates();
 
         if (fCombine)
         {
             newDlgs = dlgListDst->CopyAndCompress(oldDlgs, newDlgs, oldNum);
-
-            newDlgs->Assign(delegateTarget);
+            newDlgs = dlgListDst->CopyAndCompress(addDlgs, newDlgs, addNum);
         }
         else
         {
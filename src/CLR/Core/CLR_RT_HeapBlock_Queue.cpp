@@ -27,7 +27,12 @@ HRESULT CLR_RT_HeapBlock_Queue::Dequeue(CLR_RT_HeapBlock *&value)
 
     removed->SetObjectReference(NULL);
 
-    SetHead((head + 1) % array->m_numOfElements);
+    if (++head == (CLR_INT32)array->m_numOfElements)
+    {
+        head = 0;
+    }
+
+    SetHead(head);
 
     SetSize(size - 1);
 
@@ -43,38 +48,29 @@ HRESULT CLR_RT_HeapBlock_Queue::Enqueue(CLR_RT_HeapBlock *value)
     CLR_RT_HeapBlock_Array *array = GetArray();
     CLR_INT32 size = GetSize();
     CLR_INT32 tail = GetTail();
-    CLR_INT32 capacity = array->m_numOfElements;
 
-    if (size == capacity)
+    if (size == (CLR_INT32)array->m_numOfElements)
     {
-        // Set new capacity
-        CLR_RT_HeapBlock newArrayHB;
-
-        // Protect value from GC, in case CreateInstance triggers one
+        // Protect value from GC, in case the new array triggers one
         CLR_RT_HeapBlock valueHB;
 
         valueHB.SetObjectReference(value);
         CLR_RT_ProtectFromGC gc(valueHB);
 
-        capacity *= 2;
-
-        NANOCLR_CHECK_HRESULT(
-            CLR_RT_HeapBlock_Array::CreateInstance(newArrayHB, capacity, g_CLR_RT_WellKnownTypes.m_Object));
+        NANOCLR_CHECK_HRESULT(Grow());
 
-        array = newArrayHB.DereferenceArray();
-
-        CopyTo(array, 0);
-
-        tail = size;
-
-        SetArray(array);
-        SetHead(0);
-        SetTail(tail);
+        array = GetArray();
+        tail = GetTail();
     }
 
     ((CLR_RT_HeapBlock *)array->GetElement(tail))->SetObjectReference(value);
 
-    SetTail((tail + 1) % capacity);
+    if (++tail == (CLR_INT32)array->m_numOfElements)
+    {
+        tail = 0;
+    }
+
+    SetTail(tail);
 
     SetSize(size + 1);
 
@@ -125,20 +121,6 @@ HRESULT CLR_RT_HeapBlock_Queue::Clear()
     NANOCLR_NOCLEANUP();
 }
 
-HRESULT CLR_RT_HeapBlock_Queue::ObjArrayMemcpy(
-    CLR_RT_HeapBlock_Array *arraySrc,
-    int indexSrc,
-    CLR_RT_HeapBlock_Array *arrayDst,
-    int indexDst,
-    int length)
-{
-    NANOCLR_HEADER();
-
-    memcpy(arraySrc->GetElement(indexSrc), arrayDst->GetElement(indexDst), length * sizeof(struct CLR_RT_HeapBlock));
-
-    NANOCLR_NOCLEANUP_NOLABEL();
-}
-
 HRESULT CLR_RT_HeapBlock_Queue::CopyTo(CLR_RT_HeapBlock_Array *toArray, CLR_INT32 index)
 {
     NATIVE_PROFILE_CLR_CORE();
@@ -149,33 +131,57 @@ HRESULT CLR_RT_HeapBlock_Queue::CopyTo(CLR_RT_HeapBlock_Array *toArray, CLR_INT3
     CLR_INT32 head = Head();
     CLR_INT32 tail = GetTail();
 
-    // if the target array is of type Object, we don't need to call the complex Array::Copy() since there will be no
-    // casting involved
-    HRESULT(*arrayCopy)
-    (CLR_RT_HeapBlock_Array *, int, CLR_RT_HeapBlock_Array *, int, int) =
-        (toArray->m_typeOfElement == DATATYPE_OBJECT) ? ObjArrayMemcpy : CLR_RT_HeapBlock_Array::Copy;
-
     if (((CLR_INT32)toArray->m_numOfElements) - index < size)
         NANOCLR_SET_AND_LEAVE(CLR_E_INVALID_PARAMETER);
 
+    // Array::Copy moves the whole range at once when the destination has the same element type (object),
+    // otherwise it checks each element against the destination type
     if (size > 0)
     {
         if (head < tail)
         {
-            NANOCLR_SET_AND_LEAVE(arrayCopy(array, head, toArray, index, size));
+            NANOCLR_SET_AND_LEAVE(CLR_RT_HeapBlock_Array::Copy(array, head, toArray, index, size));
         }
         else
         {
             CLR_INT32 firstPart = array->m_numOfElements - head;
 
-            NANOCLR_CHECK_HRESULT(arrayCopy(array, head, toArray, index, firstPart));
-            NANOCLR_SET_AND_LEAVE(arrayCopy(array, 0, toArray, index + firstPart, tail));
+            NANOCLR_CHECK_HRESULT(CLR_RT_HeapBlock_Array::Copy(array, head, toArray, index, firstPart));
+            NANOCLR_SET_AND_LEAVE(CLR_RT_HeapBlock_Array::Copy(array, 0, toArray, index + firstPart, tail));
         }
     }
 
     NANOCLR_NOCLEANUP();
 }
 
+// May Trigger GC
+HRESULT CLR_RT_HeapBlock_Queue::Grow()
+{
+    NATIVE_PROFILE_CLR_CORE();
+    NANOCLR_HEADER();
+
+    CLR_RT_HeapBlock newArrayHB;
+    CLR_RT_HeapBlock_Array *newArray;
+    CLR_INT32 size = GetSize();
+    CLR_INT32 capacity = GetArray()->m_numOfElements;
+
+    capacity = (capacity < c_DefaultCapacity) ? c_DefaultCapacity : capacity * 2;
+
+    NANOCLR_CHECK_HRESULT(
+        CLR_RT_HeapBlock_Array::CreateInstance(newArrayHB, capacity, g_CLR_RT_WellKnownTypes.m_Object));
+
+    newArray = newArrayHB.DereferenceArray();
+
+    // unroll the ring at the start of the new array
+    NANOCLR_CHECK_HRESULT(CopyTo(newArray, 0));
+
+    SetArray(newArray);
+    SetHead(0);
+    SetTail(size);
+
+    NANOCLR_NOCLEANUP();
+}
+
 //--//
 
 CT_ASSERT(
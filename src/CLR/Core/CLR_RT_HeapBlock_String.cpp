@@ -11,8 +11,8 @@ CLR_RT_HeapBlock_String *CLR_RT_HeapBlock_String::CreateInstance(CLR_RT_HeapBloc
 {
     NATIVE_PROFILE_CLR_CORE();
 
-    // compute required size for the string object (header + string length + null terminator)
-    CLR_UINT32 totLength = sizeof(CLR_RT_HeapBlock_String) + length + 1;
+    // compute required size for the string object (header + cached info + string length + null terminator)
+    CLR_UINT32 totLength = sizeof(CLR_RT_HeapBlock_String) + c_CachedInfoSize + length + 1;
     CLR_RT_HeapBlock_String *str;
 
     reference.SetObjectReference(NULL);
@@ -20,12 +20,12 @@ CLR_RT_HeapBlock_String *CLR_RT_HeapBlock_String::CreateInstance(CLR_RT_HeapBloc
     str = (CLR_RT_HeapBlock_String *)g_CLR_RT_ExecutionEngine.ExtractHeapBytesForObjects(DATATYPE_STRING, 0, totLength);
     if (str)
     {
-        // grab a pointer to the string storage area (after the CLR_RT_HeapBlock_String header)
-        char const *szText = (char const *)&str[1];
-
-        // zero out the string storage area (remove size of one CLR_RT_HeapBlock)
+        // zero out the cached info and the string storage area (remove size of one CLR_RT_HeapBlock)
         totLength -= sizeof(CLR_RT_HeapBlock);
-        memset((void *)szText, 0, totLength);
+        memset((void *)&str[1], 0, totLength);
+
+        // grab a pointer to the string storage area (after the CLR_RT_HeapBlock_String header and the cached info)
+        char const *szText = (char const *)&str[1] + c_CachedInfoSize;
 
 #if defined(NANOCLR_NO_ASSEMBLY_STRINGS)
         str->SetStringText(szText);
@@ -66,7 +66,7 @@ HRESULT CLR_RT_HeapBlock_String::CreateInstance(CLR_RT_HeapBlock &reference, con
     str = CreateInstance(reference, length);
     CHECK_ALLOCATION(str);
 
-    // grab a pointer to the string storage area (after the CLR_RT_HeapBlock_String header)
+    // grab a pointer to the string storage area
     szTextDst = str->StringText();
 
     // copy the string to the storage area
@@ -118,9 +118,38 @@ HRESULT CLR_RT_HeapBlock_String::CreateInstance(CLR_RT_HeapBlock &reference, CLR
     NANOCLR_HEADER();
 
     CLR_RT_UnicodeHelper uh;
+    CLR_RT_HeapBlock_String *str;
+    CLR_UINT32 lengthInBytes;
+    CLR_UINT32 i = 0;
+
+    // ASCII text (the common case) is narrowed in a single pass, without going through the UTF-8 encoder
+    while (i < length && szText[i] != 0 && szText[i] < 0x80)
+    {
+        i++;
+    }
+
+    if (i == length)
+    {
+        char *szTextDst;
+
+        str = CreateInstance(reference, length);
+        CHECK_ALLOCATION(str);
+
+        szTextDst = (char *)str->StringText();
+
+        for (i = 0; i < length; i++)
+        {
+            szTextDst[i] = (char)szText[i];
+        }
+
+        str->SetAsciiTextInfo(length);
+
+        NANOCLR_SET_AND_LEAVE(S_OK);
+    }
+
     uh.SetInputUTF16(szText);
-    CLR_UINT32 lengthInBytes = uh.CountNumberOfBytes(length);
-    CLR_RT_HeapBlock_String const *str = CreateInstance(reference, lengthInBytes);
+    lengthInBytes = uh.CountNumberOfBytes(length);
+    str = CreateInstance(reference, lengthInBytes);
     CHECK_ALLOCATION(str);
 
     uh.m_outputUTF8 = (CLR_UINT8 *)str->StringText();
@@ -137,3 +166,276 @@ CLR_RT_HeapBlock_String *CLR_RT_HeapBlock_String::GetStringEmpty()
         ->GetStaticField(Library_corlib_native_System_String::FIELD_STATIC__Empty)
         ->DereferenceString();
 }
+
+HRESULT CLR_RT_HeapBlock_String::CreateConcatenation(
+    CLR_RT_HeapBlock &reference,
+    CLR_RT_HeapBlock *parts,
+    CLR_UINT32 count)
+{
+    NATIVE_PROFILE_CLR_CORE();
+    NANOCLR_HEADER();
+
+    CLR_RT_HeapBlock_String *single = NULL;
+    CLR_RT_HeapBlock_String *str;
+    CLR_UINT32 totLength = 0;
+    CLR_UINT32 totChars = 0;
+    CLR_UINT32 nonEmpty = 0;
+    bool fAscii = true;
+    char *szTextDst;
+
+    // 1st pass: compute the final length, so the result is allocated only once
+    for (CLR_UINT32 i = 0; i < count; i++)
+    {
+        CLR_RT_HeapBlock *ptr = parts[i].Dereference();
+
+        if (ptr != NULL && ptr->DataType() == DATATYPE_STRING && ptr->StringText() != NULL)
+        {
+            CLR_RT_HeapBlock_String *part = (CLR_RT_HeapBlock_String *)ptr;
+            CLR_UINT32 length = part->GetLengthInBytes();
+
+            if (length > 0)
+            {
+                single = part;
+                nonEmpty++;
+
+                totLength += length;
+
+                if (fAscii && part->IsAscii())
+                {
+                    totChars += length;
+                }
+                else
+                {
+                    fAscii = false;
+                }
+            }
+        }
+    }
+
+    // strings are immutable, when there's only one non empty part it can be returned as is
+    if (nonEmpty == 1)
+    {
+        reference.SetObjectReference(single);
+
+        NANOCLR_SET_AND_LEAVE(S_OK);
+    }
+
+    str = CreateInstance(reference, totLength);
+    CHECK_ALLOCATION(str);
+
+    // 2nd pass: copy the parts
+    szTextDst = (char *)str->StringText();
+
+    for (CLR_UINT32 i = 0; i < count; i++)
+    {
+        CLR_RT_HeapBlock *ptr = parts[i].Dereference();
+
+        if (ptr != NULL && ptr->DataType() == DATATYPE_STRING && ptr->StringText() != NULL)
+        {
+            CLR_UINT32 length = ((CLR_RT_HeapBlock_String *)ptr)->GetLengthInBytes();
+
+            memcpy(szTextDst, ptr->StringText(), length);
+
+            szTextDst += length;
+        }
+    }
+
+    // when all the parts are ASCII so is the result, no need to scan it later
+    if (fAscii)
+    {
+        str->SetAsciiTextInfo(totChars);
+    }
+
+    NANOCLR_NOCLEANUP();
+}
+
+CLR_UINT32 CLR_RT_HeapBlock_String::ComputeTextInfo(const char *szText)
+{
+    NATIVE_PROFILE_CLR_CORE();
+
+    const CLR_UINT8 *ptr = (const CLR_UINT8 *)szText;
+    CLR_RT_UnicodeHelper uh;
+    int length;
+
+    // skip the ASCII part, for which each byte is one character
+    while (*ptr != 0 && *ptr < 0x80)
+    {
+        ptr++;
+    }
+
+    if (*ptr == 0)
+    {
+        return c_TextInfo_Computed | c_TextInfo_Ascii | ((CLR_UINT32)(ptr - (const CLR_UINT8 *)szText));
+    }
+
+    uh.SetInputUTF8((const char *)ptr);
+    length = uh.CountNumberOfCharacters();
+
+    if (length < 0)
+    {
+        return c_TextInfo_Computed | c_TextInfo_Invalid;
+    }
+
+    return c_TextInfo_Computed | ((CLR_UINT32)(ptr - (const CLR_UINT8 *)szText + length) & c_TextInfo_LengthMask);
+}
+
+CLR_UINT32 *CLR_RT_HeapBlock_String::GetCachedInfo()
+{
+    NATIVE_PROFILE_CLR_CORE();
+
+    CLR_UINT32 *info = (CLR_UINT32 *)&this[1];
+
+    // only strings with the text stored in this heap block have room to cache the info
+    if (StringText() != (const char *)info + c_CachedInfoSize)
+    {
+        return NULL;
+    }
+
+    return info;
+}
+
+CLR_UINT32 CLR_RT_HeapBlock_String::GetTextInfo()
+{
+    NATIVE_PROFILE_CLR_CORE();
+
+    CLR_UINT32 *info = GetCachedInfo();
+
+    if (info == NULL)
+    {
+        return ComputeTextInfo(StringText());
+    }
+
+    if ((info[0] & c_TextInfo_Computed) == 0)
+    {
+        info[0] = ComputeTextInfo(StringText());
+    }
+
+    return info[0];
+}
+
+void CLR_RT_HeapBlock_String::SetAsciiTextInfo(CLR_UINT32 length)
+{
+    NATIVE_PROFILE_CLR_CORE();
+
+    *(CLR_UINT32 *)&this[1] = c_TextInfo_Computed | c_TextInfo_Ascii | (length & c_TextInfo_LengthMask);
+}
+
+CLR_UINT32 CLR_RT_HeapBlock_String::ComputeHashCode(const char *szText, CLR_UINT32 length)
+{
+    NATIVE_PROFILE_CLR_CORE();
+
+    // MurmurHash3 (x86, 32 bits) over the UTF-8 bytes: four bytes per round and 32 bit multiplies only, so it's
+    // cheap on any MCU and doesn't need the byte-at-a-time table lookups of the CRC
+    const CLR_UINT32 c1 = 0xCC9E2D51;
+    const CLR_UINT32 c2 = 0x1B873593;
+    const CLR_UINT8 *ptr = (const CLR_UINT8 *)szText;
+    CLR_UINT32 hash = 0x9747B28C;
+    CLR_UINT32 rounds = length / 4;
+    CLR_UINT32 k;
+
+    while (rounds-- > 0)
+    {
+        // the text isn't necessarily word aligned
+        k = (CLR_UINT32)ptr[0] | ((CLR_UINT32)ptr[1] << 8) | ((CLR_UINT32)ptr[2] << 16) | ((CLR_UINT32)ptr[3] << 24);
+        ptr += 4;
+
+        k *= c1;
+        k = (k << 15) | (k >> 17);
+        k *= c2;
+
+        hash ^= k;
+        hash = (hash << 13) | (hash >> 19);
+        hash = hash * 5 + 0xE6546B64;
+    }
+
+    k = 0;
+
+    switch (length & 3)
+    {
+        case 3:
+            k ^= (CLR_UINT32)ptr[2] << 16;
+            // fall through
+        case 2:
+            k ^= (CLR_UINT32)ptr[1] << 8;
+            // fall through
+        case 1:
+            k ^= ptr[0];
+
+            k *= c1;
+            k = (k << 15) | (k >> 17);
+            k *= c2;
+            hash ^= k;
+            break;
+
+        default:
+            break;
+    }
+
+    hash ^= length;
+    hash ^= hash >> 16;
+    hash *= 0x85EBCA6B;
+    hash ^= hash >> 13;
+    hash *= 0xC2B2AE35;
+    hash ^= hash >> 16;
+
+    return hash;
+}
+
+CLR_UINT32 CLR_RT_HeapBlock_String::GetTextHashCode()
+{
+    NATIVE_PROFILE_CLR_CORE();
+
+    CLR_UINT32 *info = GetCachedInfo();
+    CLR_UINT32 hash;
+
+    if (info != NULL && info[1] != 0)
+    {
+        return info[1];
+    }
+
+    hash = ComputeHashCode(StringText(), GetLengthInBytes());
+
+    // 0 marks the hash code as not computed, a text hashing to it is just computed again on the next call
+    if (info != NULL)
+    {
+        info[1] = hash;
+    }
+
+    return hash;
+}
+
+int CLR_RT_HeapBlock_String::GetLength()
+{
+    NATIVE_PROFILE_CLR_CORE();
+
+    CLR_UINT32 info = GetTextInfo();
+
+    if (info & c_TextInfo_Invalid)
+    {
+        return -1;
+    }
+
+    return (int)(info & c_TextInfo_LengthMask);
+}
+
+CLR_UINT32 CLR_RT_HeapBlock_String::GetLengthInBytes()
+{
+    NATIVE_PROFILE_CLR_CORE();
+
+    CLR_UINT32 info = GetTextInfo();
+
+    // ASCII strings have one byte per character
+    if (info & c_TextInfo_Ascii)
+    {
+        return info & c_TextInfo_LengthMask;
+    }
+
+    return (CLR_UINT32)hal_strlen_s(StringText());
+}
+
+bool CLR_RT_HeapBlock_String::IsAscii()
+{
+    NATIVE_PROFILE_CLR_CORE();
+
+    return (GetTextInfo() & c_TextInfo_Ascii) != 0;
+}
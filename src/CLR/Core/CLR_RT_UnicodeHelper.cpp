@@ -19,16 +19,51 @@
     ch2 <<= 6;                                                                                                         \
     ch2 |= (ch & 0x3F)
 
+// a sequence cut short by the end of a bounded input is as illegal as one cut short by the terminator
+#define UTF8_CHECK_TRAILING(src, end, count)                                                                           \
+    if (end != NULL && (end - src) < count)                                                                            \
+    return -1
+
+#define IS_WORD_ALIGNED(ptr) (((size_t)(ptr) & (sizeof(CLR_UINT32) - 1)) == 0)
+
+// true when all 4 bytes are ASCII and none of them is the terminator
+static inline bool IsAsciiWord(const CLR_UINT8 *src)
+{
+    CLR_UINT32 word;
+
+    memcpy(&word, src, sizeof(word));
+
+    // a zero byte borrows into its top bit, non-ASCII bytes have it set already
+    return ((word | (word - 0x01010101)) & 0x80808080) == 0;
+}
+
+// true for ASCII bytes other than the terminator
+#define IS_ASCII_CHAR(ch) ((CLR_UINT32)(ch) - 1 < 0x7F)
+
 //--//
 
-int CLR_RT_UnicodeHelper::CountNumberOfCharacters(int max)
+int CLR_RT_UnicodeHelper::CountNumberOfCharacters(int max, int maxBytes)
 {
     NATIVE_PROFILE_CLR_CORE();
     const CLR_UINT8 *pSrc = m_inputUTF8;
+    const CLR_UINT8 *pEnd = (maxBytes < 0) ? NULL : pSrc + maxBytes;
     int num = 0;
 
     while (true)
     {
+        // runs of ASCII are checked a word at a time, when there are no limits to keep track of
+        if (pEnd == NULL && max < 0)
+        {
+            while (IS_WORD_ALIGNED(pSrc) && IsAsciiWord(pSrc))
+            {
+                pSrc += 4;
+                num += 4;
+            }
+        }
+
+        if (pSrc == pEnd)
+            break;
+
         CLR_UINT32 ch = (CLR_UINT32)*pSrc++;
         if (!ch)
             break;
@@ -57,12 +92,14 @@ int CLR_RT_UnicodeHelper::CountNumberOfCharacters(int max)
 
             case 0xC0:
             case 0xD0:
+                UTF8_CHECK_TRAILING(pSrc, pEnd, 1);
                 UTF8_CHECK_LOWPART(ch, pSrc);
 
                 num += 1;
                 break;
 
             case 0xE0:
+                UTF8_CHECK_TRAILING(pSrc, pEnd, 2);
                 UTF8_CHECK_LOWPART(ch, pSrc);
                 UTF8_CHECK_LOWPART(ch, pSrc);
 
@@ -70,6 +107,7 @@ int CLR_RT_UnicodeHelper::CountNumberOfCharacters(int max)
                 break;
 
             case 0xF0:
+                UTF8_CHECK_TRAILING(pSrc, pEnd, 3);
                 UTF8_CHECK_LOWPART(ch, pSrc);
                 UTF8_CHECK_LOWPART(ch, pSrc);
                 UTF8_CHECK_LOWPART(ch, pSrc);
@@ -90,6 +128,14 @@ int CLR_RT_UnicodeHelper::CountNumberOfBytes(int max)
 
     while (true)
     {
+        // runs of ASCII, one byte per character
+        while (max != 0 && IS_ASCII_CHAR(*pSrc))
+        {
+            pSrc++;
+            num++;
+            max--;
+        }
+
         CLR_UINT16 ch = *pSrc++;
         if (!ch)
             break;
@@ -162,6 +208,64 @@ bool CLR_RT_UnicodeHelper::ConvertFromUTF8(int iMaxChars, bool fJustMove, int iM
 
     while (iMaxChars > 0 && iMaxBytes > 0)
     {
+        // runs of ASCII map one byte to one char, no need to go through the decoder
+        if (IS_ASCII_CHAR(*inputUTF8))
+        {
+            const CLR_UINT8 *runStart = inputUTF8;
+            int run = (iMaxChars < iMaxBytes) ? iMaxChars : iMaxBytes;
+
+            if (fJustMove)
+            {
+                while (run >= 4 && IS_WORD_ALIGNED(inputUTF8) && IsAsciiWord(inputUTF8))
+                {
+                    inputUTF8 += 4;
+                    run -= 4;
+                }
+
+                while (run > 0 && IS_ASCII_CHAR(*inputUTF8))
+                {
+                    inputUTF8++;
+                    run--;
+                }
+            }
+            else
+            {
+                if (run > outputUTF16_size)
+                {
+                    run = outputUTF16_size;
+                }
+
+                while (run >= 4 && IS_WORD_ALIGNED(inputUTF8) && IsAsciiWord(inputUTF8))
+                {
+                    outputUTF16[0] = inputUTF8[0];
+                    outputUTF16[1] = inputUTF8[1];
+                    outputUTF16[2] = inputUTF8[2];
+                    outputUTF16[3] = inputUTF8[3];
+
+                    inputUTF8 += 4;
+                    outputUTF16 += 4;
+                    run -= 4;
+                }
+
+                while (run > 0 && IS_ASCII_CHAR(*inputUTF8))
+                {
+                    *outputUTF16++ = *inputUTF8++;
+                    run--;
+                }
+
+                outputUTF16_size -= (int)(inputUTF8 - runStart);
+            }
+
+            iMaxChars -= (int)(inputUTF8 - runStart);
+            iMaxBytes -= (int)(inputUTF8 - runStart);
+
+            // when the output is full nothing was taken, the decoder below deals with that
+            if (inputUTF8 != runStart)
+            {
+                continue;
+            }
+        }
+
         ch = (CLR_UINT32)*inputUTF8++;
 
         switch (ch & 0xF0)
@@ -399,6 +503,45 @@ bool CLR_RT_UnicodeHelper::ConvertToUTF8(int iMaxChars, bool fJustMove)
 
     while (iMaxChars > 0)
     {
+        // runs of ASCII map one char to one byte
+        if (IS_ASCII_CHAR(*inputUTF16))
+        {
+            const CLR_UINT16 *runStart = inputUTF16;
+            int run = iMaxChars;
+
+            if (fJustMove)
+            {
+                while (run > 0 && IS_ASCII_CHAR(*inputUTF16))
+                {
+                    inputUTF16++;
+                    run--;
+                }
+            }
+            else
+            {
+                if (run > outputUTF8_size)
+                {
+                    run = outputUTF8_size;
+                }
+
+                while (run > 0 && IS_ASCII_CHAR(*inputUTF16))
+                {
+                    *outputUTF8++ = (CLR_UINT8)*inputUTF16++;
+                    run--;
+                }
+
+                outputUTF8_size -= (int)(inputUTF16 - runStart);
+            }
+
+            iMaxChars -= (int)(inputUTF16 - runStart);
+
+            // when the output is full nothing was taken, the encoder below deals with that
+            if (inputUTF16 != runStart)
+            {
+                continue;
+            }
+        }
+
         ch = (CLR_UINT32)*inputUTF16++;
 
         if (ch < 0x0080)
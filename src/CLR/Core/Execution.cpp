@@ -35,6 +35,8 @@ HRESULT CLR_RT_ExecutionEngine::CreateInstance(CLR_SETTINGS params)
     g_CLR_RT_ExecutionEngine.m_fPerformGarbageCollection = params.PerformGarbageCollection;
     g_CLR_RT_ExecutionEngine.m_fPerformHeapCompaction = params.PerformHeapCompaction;
 
+    g_CLR_RT_ExecutionEngine.ConfigureScheduler(params);
+
     NANOCLR_CHECK_HRESULT(g_CLR_RT_ExecutionEngine.ExecutionEngine_Initialize());
 
     NANOCLR_NOCLEANUP();
@@ -80,7 +82,12 @@ HRESULT CLR_RT_ExecutionEngine::ExecutionEngine_Initialize()
     m_timers.DblLinkedList_Initialize();            // CLR_RT_DblLinkedList                m_timers;
     m_raisedEvents = 0;                             // CLR_UINT32                          m_raisedEvents;
                                                     //
-    m_threadsReady.DblLinkedList_Initialize();      // CLR_RT_DblLinkedList                m_threadsReady;
+    for (int band = 0; band < c_ThreadReadyBands; band++)
+    {
+        m_threadsReady[band].DblLinkedList_Initialize(); // CLR_RT_DblLinkedList           m_threadsReady[];
+    }
+    m_threadsReadyBands = 0;                        // CLR_UINT32                          m_threadsReadyBands;
+    m_threadsReadySequence = 0;                     // CLR_UINT32                          m_threadsReadySequence;
     m_threadsWaiting.DblLinkedList_Initialize();    // CLR_RT_DblLinkedList                m_threadsWaiting;
     m_threadsZombie.DblLinkedList_Initialize();     // CLR_RT_DblLinkedList                m_threadsZombie;
                                                     // int                                 m_lastPid;
@@ -96,6 +103,15 @@ HRESULT CLR_RT_ExecutionEngine::ExecutionEngine_Initialize()
 
     m_currentUICulture = NULL; // CLR_RT_HeapBlock*                   m_currentUICulture;
 
+    m_identityHashCodes = NULL;   // IdentityHashCode*                   m_identityHashCodes;
+    m_identityHashCodesCount = 0; // CLR_UINT32                          m_identityHashCodesCount;
+    m_identityHashCodesSize = 0;  // CLR_UINT32                          m_identityHashCodesSize;
+    m_identityHashCodeNext = 0;   // CLR_UINT32                          m_identityHashCodeNext;
+    m_identityHashCodesMissed = 0; // CLR_UINT32                         m_identityHashCodesMissed;
+
+    memset(m_reflectionLookups, 0, sizeof(m_reflectionLookups)); // ReflectionLookup m_reflectionLookups[];
+    memset(m_reflectionObjects, 0, sizeof(m_reflectionObjects)); // CLR_RT_HeapBlock* m_reflectionObjects[];
+
     CLR_RT_HeapBlock_EndPoint::HandlerMethod_Initialize();
     CLR_RT_HeapBlock_NativeEventDispatcher::HandlerMethod_Initialize();
 
@@ -279,6 +295,16 @@ void CLR_RT_ExecutionEngine::ExecutionEngine_Cleanup()
 
     m_interruptThread = NULL;
 
+    // the table lives in the heap that is about to be discarded
+    m_identityHashCodes = NULL;
+    m_identityHashCodesBuckets = NULL;
+    m_identityHashCodesCount = 0;
+    m_identityHashCodesSize = 0;
+
+    // the assemblies are reloaded on the next start, the indexes in the lookups may point somewhere else
+    memset(m_reflectionLookups, 0, sizeof(m_reflectionLookups));
+    memset(m_reflectionObjects, 0, sizeof(m_reflectionObjects));
+
     m_heap.DblLinkedList_Initialize();
 }
 
@@ -432,6 +458,16 @@ void CLR_RT_ExecutionEngine::PerformHeapCompaction()
     m_lastHcUsed = NULL;
 }
 
+static CLR_UINT32 IdentityHashCodes_Bucket(CLR_RT_HeapBlock *obj, CLR_UINT32 mask)
+{
+    // heap blocks are aligned, drop the bits that never change before spreading the address
+    CLR_UINT32 hash = (CLR_UINT32)((size_t)obj / sizeof(CLR_RT_HeapBlock)) * 0x9E3779B1;
+
+    hash ^= hash >> 16;
+
+    return hash & mask;
+}
+
 void CLR_RT_ExecutionEngine::Relocate()
 {
     NATIVE_PROFILE_CLR_CORE();
@@ -454,6 +490,305 @@ void CLR_RT_ExecutionEngine::Relocate()
     CLR_RT_GarbageCollector::Heap_Relocate((void **)&m_currentUICulture);
 
     m_weakReferences.Relocate();
+
+    for (CLR_UINT32 i = 0; i < c_ReflectionCache_Size; i++)
+    {
+        CLR_RT_GarbageCollector::Heap_Relocate((void **)&m_reflectionObjects[i]);
+    }
+
+    if (m_identityHashCodesCount)
+    {
+        IdentityHashCode *entries = m_identityHashCodes;
+
+        for (CLR_UINT32 i = 0; i < m_identityHashCodesCount; i++)
+        {
+            CLR_RT_GarbageCollector::Heap_Relocate((void **)&entries[i].m_object);
+        }
+
+        // the objects have moved, so have their buckets
+        IdentityHashCodes_Rehash();
+    }
+}
+
+CLR_UINT32 CLR_RT_ExecutionEngine::GetIdentityHashCode(CLR_RT_HeapBlock *obj)
+{
+    NATIVE_PROFILE_CLR_CORE();
+
+    IdentityHashCode *entries = m_identityHashCodes;
+    CLR_UINT32 *buckets = m_identityHashCodesBuckets;
+    CLR_UINT32 mask = m_identityHashCodesSize * 2 - 1;
+    CLR_UINT32 slot = 0;
+    CLR_UINT32 index;
+    CLR_UINT32 hashCode;
+
+    if (m_identityHashCodesSize)
+    {
+        // the index is never more than half full, so the probe stops on a free bucket after a few steps
+        for (slot = IdentityHashCodes_Bucket(obj, mask); (index = buckets[slot]) != 0; slot = (slot + 1) & mask)
+        {
+            if (entries[index - 1].m_object == obj)
+            {
+                return entries[index - 1].m_hashCode;
+            }
+        }
+    }
+
+    if (m_identityHashCodesCount == m_identityHashCodesSize)
+    {
+        // the table can't grow here, the caller holds raw pointers to objects that a compaction would move:
+        // record the miss and let the caller reserve room at a safe point and ask again
+        m_identityHashCodesMissed++;
+
+        return 0;
+    }
+
+    // Fibonacci hashing of a sequence number: unique for the first 2^32 objects and well spread over the bits
+    hashCode = ++m_identityHashCodeNext * 0x9E3779B1;
+
+    entries[m_identityHashCodesCount].m_object = obj;
+    entries[m_identityHashCodesCount].m_hashCode = hashCode;
+
+    buckets[slot] = ++m_identityHashCodesCount;
+
+    return hashCode;
+}
+
+HRESULT CLR_RT_ExecutionEngine::IdentityHashCodes_Reserve(CLR_UINT32 count)
+{
+    NATIVE_PROFILE_CLR_CORE();
+    NANOCLR_HEADER();
+
+    IdentityHashCode *entries;
+    CLR_UINT32 size;
+
+    if (m_identityHashCodesCount + count <= m_identityHashCodesSize)
+    {
+        NANOCLR_SET_AND_LEAVE(S_OK);
+    }
+
+    size = m_identityHashCodesSize ? m_identityHashCodesSize * 2 : c_IdentityHashCodes_InitialSize;
+
+    while (size < m_identityHashCodesCount + count)
+    {
+        size *= 2;
+    }
+
+    entries = (IdentityHashCode *)CLR_RT_Memory::Allocate(
+        size * sizeof(IdentityHashCode) + size * 2 * sizeof(CLR_UINT32),
+        CLR_RT_HeapBlock::HB_CompactOnFailure);
+    CHECK_ALLOCATION(entries);
+
+    // a GC run by the allocation may have purged the table, so only look at it now
+    if (m_identityHashCodes)
+    {
+        memcpy(entries, m_identityHashCodes, m_identityHashCodesCount * sizeof(IdentityHashCode));
+
+        CLR_RT_Memory::Release(m_identityHashCodes);
+    }
+
+    m_identityHashCodes = entries;
+    m_identityHashCodesBuckets = (CLR_UINT32 *)&entries[size];
+    m_identityHashCodesSize = size;
+
+    IdentityHashCodes_Rehash();
+
+    NANOCLR_NOCLEANUP();
+}
+
+void CLR_RT_ExecutionEngine::IdentityHashCodes_Purge()
+{
+    NATIVE_PROFILE_CLR_CORE();
+
+    IdentityHashCode *entries = m_identityHashCodes;
+    CLR_UINT32 kept = 0;
+
+    // called after the mark phase, before the dead objects are reclaimed and their memory can be reused
+    for (CLR_UINT32 i = 0; i < m_identityHashCodesCount; i++)
+    {
+        if (entries[i].m_object->IsAlive())
+        {
+            entries[kept++] = entries[i];
+        }
+    }
+
+    if (kept == m_identityHashCodesCount)
+    {
+        return;
+    }
+
+    m_identityHashCodesCount = kept;
+
+    if (kept == 0 && m_identityHashCodes)
+    {
+        CLR_RT_Memory::Release(m_identityHashCodes);
+
+        m_identityHashCodes = NULL;
+        m_identityHashCodesBuckets = NULL;
+        m_identityHashCodesSize = 0;
+    }
+    else
+    {
+        // the surviving entries have moved down the table
+        IdentityHashCodes_Rehash();
+    }
+}
+
+void CLR_RT_ExecutionEngine::IdentityHashCodes_Rehash()
+{
+    NATIVE_PROFILE_CLR_CORE();
+
+    IdentityHashCode *entries = m_identityHashCodes;
+    CLR_UINT32 *buckets = m_identityHashCodesBuckets;
+    CLR_UINT32 mask = m_identityHashCodesSize * 2 - 1;
+
+    if (m_identityHashCodesSize == 0)
+    {
+        return;
+    }
+
+    memset(buckets, 0, m_identityHashCodesSize * 2 * sizeof(CLR_UINT32));
+
+    for (CLR_UINT32 i = 0; i < m_identityHashCodesCount; i++)
+    {
+        CLR_UINT32 slot = IdentityHashCodes_Bucket(entries[i].m_object, mask);
+
+        while (buckets[slot] != 0)
+        {
+            slot = (slot + 1) & mask;
+        }
+
+        buckets[slot] = i + 1;
+    }
+}
+
+//--//
+
+static CLR_UINT32 ReflectionLookup_Slot(CLR_UINT32 type, CLR_UINT32 nameHash, CLR_UINT32 flags)
+{
+    CLR_UINT32 hash = nameHash ^ (type * 0x9E3779B1) ^ (flags * 0x85EBCA6B);
+
+    hash ^= hash >> 16;
+
+    return hash & (CLR_RT_ExecutionEngine::c_ReflectionCache_Size - 1);
+}
+
+bool CLR_RT_ExecutionEngine::ReflectionLookup_Find(
+    const CLR_RT_TypeDef_Index &type,
+    const char *name,
+    CLR_UINT32 flags,
+    CLR_UINT32 &member)
+{
+    NATIVE_PROFILE_CLR_CORE();
+
+    CLR_UINT32 nameHash = CLR_RT_HeapBlock_String::ComputeHashCode(name, (CLR_UINT32)hal_strlen_s(name));
+    ReflectionLookup &entry = m_reflectionLookups[ReflectionLookup_Slot(type.m_data, nameHash, flags)];
+    const char *memberName;
+
+    if (entry.m_type != type.m_data || entry.m_nameHash != nameHash || entry.m_flags != flags)
+    {
+        return false;
+    }
+
+    // the hash only narrows it down, the name has to match too
+    if (flags & c_ReflectionLookup_Field)
+    {
+        CLR_RT_FieldDef_Index idx;
+        CLR_RT_FieldDef_Instance inst{};
+
+        idx.m_data = entry.m_member;
+
+        if (inst.InitializeFromIndex(idx) == false)
+        {
+            return false;
+        }
+
+        memberName = inst.m_assm->GetString(inst.m_target->name);
+    }
+    else
+    {
+        CLR_RT_MethodDef_Index idx;
+        CLR_RT_MethodDef_Instance inst{};
+
+        idx.m_data = entry.m_member;
+
+        if (inst.InitializeFromIndex(idx) == false)
+        {
+            return false;
+        }
+
+        memberName = inst.m_assm->GetString(inst.m_target->name);
+    }
+
+    if (strcmp(memberName, name) != 0)
+    {
+        return false;
+    }
+
+    member = entry.m_member;
+
+    return true;
+}
+
+void CLR_RT_ExecutionEngine::ReflectionLookup_Add(
+    const CLR_RT_TypeDef_Index &type,
+    const char *name,
+    CLR_UINT32 flags,
+    CLR_UINT32 member)
+{
+    NATIVE_PROFILE_CLR_CORE();
+
+    CLR_UINT32 nameHash = CLR_RT_HeapBlock_String::ComputeHashCode(name, (CLR_UINT32)hal_strlen_s(name));
+    ReflectionLookup &entry = m_reflectionLookups[ReflectionLookup_Slot(type.m_data, nameHash, flags)];
+
+    // direct mapped: a new lookup simply evicts whatever was in its slot
+    entry.m_type = type.m_data;
+    entry.m_nameHash = nameHash;
+    entry.m_flags = flags;
+    entry.m_member = member;
+}
+
+HRESULT CLR_RT_ExecutionEngine::GetReflectionObject(
+    CLR_RT_HeapBlock &ref,
+    const CLR_RT_TypeDef_Index &cls,
+    const CLR_RT_FieldDef_Index &fd)
+{
+    NATIVE_PROFILE_CLR_CORE();
+    NANOCLR_HEADER();
+
+    CLR_UINT32 slot = ((fd.m_data * 0x9E3779B1) >> 16) & (c_ReflectionCache_Size - 1);
+    CLR_RT_HeapBlock *obj = m_reflectionObjects[slot];
+
+    if (obj && obj->DataType() == DATATYPE_REFLECTION && obj->ReflectionDataConst().m_kind == REFLECTION_FIELD &&
+        obj->ReflectionDataConst().m_data.m_field.m_data == fd.m_data)
+    {
+        ref.SetObjectReference(obj);
+
+        NANOCLR_SET_AND_LEAVE(S_OK);
+    }
+
+    NANOCLR_CHECK_HRESULT(NewObjectFromIndex(ref, cls));
+
+    obj = ref.Dereference();
+
+    NANOCLR_CHECK_HRESULT(obj->SetReflection(fd));
+
+    m_reflectionObjects[slot] = obj;
+
+    NANOCLR_NOCLEANUP();
+}
+
+void CLR_RT_ExecutionEngine::ReflectionCache_Purge()
+{
+    NATIVE_PROFILE_CLR_CORE();
+
+    // called after the mark phase: the cache alone doesn't keep an object alive
+    for (CLR_UINT32 i = 0; i < c_ReflectionCache_Size; i++)
+    {
+        if (m_reflectionObjects[i] && m_reflectionObjects[i]->IsAlive() == false)
+        {
+            m_reflectionObjects[i] = NULL;
+        }
+    }
 }
 
 //--//
@@ -511,7 +846,10 @@ bool CLR_RT_ExecutionEngine::TryToUnloadAppDomains()
     TryToUnloadAppDomains_Helper_Finalizers(m_finalizersAlive, true);
     TryToUnloadAppDomains_Helper_Finalizers(m_finalizersPending, false);
 
-    TryToUnloadAppDomains_Helper_Threads(m_threadsReady);
+    for (int band = 0; band < c_ThreadReadyBands; band++)
+    {
+        TryToUnloadAppDomains_Helper_Threads(m_threadsReady[band]);
+    }
     TryToUnloadAppDomains_Helper_Threads(m_threadsWaiting);
 
     CLR_EE_CLR(UnloadingAppDomain);
@@ -1157,7 +1495,10 @@ HRESULT CLR_RT_ExecutionEngine::ScheduleThreads(int maxContextSwitch)
         // AdjustExecutionCounter gets const & to list of threads.
         // List of threads is not modified, but m_executionCounter is bumped up in each thread.
 
-        AdjustExecutionCounter(m_threadsReady, EXECUTION_COUNTER_ADJUSTMENT);
+        for (int band = 0; band < c_ThreadReadyBands; band++)
+        {
+            AdjustExecutionCounter(m_threadsReady[band], EXECUTION_COUNTER_ADJUSTMENT);
+        }
         AdjustExecutionCounter(m_threadsWaiting, EXECUTION_COUNTER_ADJUSTMENT);
         AdjustExecutionCounter(m_threadsZombie, EXECUTION_COUNTER_ADJUSTMENT);
     }
@@ -1186,7 +1527,7 @@ HRESULT CLR_RT_ExecutionEngine::ScheduleThreads(int maxContextSwitch)
         if (m_cctorThread == NULL)
         {
             // This is normal case execution. Looks for first ready thread.
-            th = (CLR_RT_Thread *)m_threadsReady.FirstNode();
+            th = FirstReadyThread();
         }
         else // If a static constructor thread exists, we should be running it.
         {
@@ -1204,15 +1545,15 @@ HRESULT CLR_RT_ExecutionEngine::ScheduleThreads(int maxContextSwitch)
             }
         }
 
-        // If th->Next() is NULL, then there are no Ready to run threads in the system.
+        // If th is NULL, then there are no Ready to run threads in the system.
         // In this case we spawn finalizer and make finalizer thread as ready one.
-        if (th->Next() == NULL)
+        if (th == NULL)
         {
             g_CLR_RT_ExecutionEngine.SpawnFinalizer();
 
             // Now finalizer thread might be in ready state if there are object that need call to finalizer.
             // th might point to finilizer thread.
-            th = (CLR_RT_Thread *)m_threadsReady.FirstNode();
+            th = FirstReadyThread();
 
             // Thread create can cause stopping debugging event
 #if defined(NANOCLR_ENABLE_SOURCELEVELDEBUGGING)
@@ -1224,7 +1565,7 @@ HRESULT CLR_RT_ExecutionEngine::ScheduleThreads(int maxContextSwitch)
         }
 
         // If there is ready thread - decrease m_executionCounter for this (th) thread.
-        if (th->Next() != NULL)
+        if (th != NULL)
         {
             // The value to update m_executionCounter for each run. See comment for GetQuantumDebit for possible values
             int debitForEachRun = th->GetQuantumDebit();
@@ -1254,6 +1595,15 @@ HRESULT CLR_RT_ExecutionEngine::ScheduleThreads(int maxContextSwitch)
 
         Watchdog_Reset();
 
+#if defined(NANOCLR_PROFILE_NEW_CALLS)
+        if (th->m_readyTime != 0)
+        {
+            g_CLR_PRF_Profiler.RecordSchedulingLatency(th, HAL_Time_CurrentTime() - th->m_readyTime);
+
+            th->m_readyTime = 0;
+        }
+#endif
+
         {
             // Runs the tread until expiration of its quantum or until thread is blocked.
             hr = th->Execute();
@@ -1313,7 +1663,7 @@ CLR_UINT32 CLR_RT_ExecutionEngine::WaitForActivity()
 
     CLR_INT64 timeoutMin = ProcessTimer();
 
-    if (m_threadsReady.IsEmpty() == false)
+    if (HasReadyThreads())
         return 0; // Someone woke up...
 
     if (timeoutMin > 0LL)
@@ -1359,7 +1709,7 @@ void CLR_RT_ExecutionEngine::PutInProperList(CLR_RT_Thread *th)
         case CLR_RT_Thread::TH_S_Ready:
             if ((th->m_flags & CLR_RT_Thread::TH_F_Suspended) == 0)
             {
-                InsertThreadRoundRobin(m_threadsReady, th);
+                InsertThreadRoundRobin(th);
                 break;
             }
             //
@@ -1367,6 +1717,9 @@ void CLR_RT_ExecutionEngine::PutInProperList(CLR_RT_Thread *th)
             //
         case CLR_RT_Thread::TH_S_Waiting:
             m_threadsWaiting.LinkAtBack(th);
+#if defined(NANOCLR_PROFILE_NEW_CALLS)
+            th->m_readyTime = 0;
+#endif
             break;
 
         case CLR_RT_Thread::TH_S_Terminated:
@@ -1407,28 +1760,41 @@ void CLR_RT_ExecutionEngine::ReleaseAllThreads(CLR_RT_DblLinkedList &threads)
     }
 }
 
-void CLR_RT_ExecutionEngine::InsertThreadRoundRobin(CLR_RT_DblLinkedList &threads, CLR_RT_Thread *thTarget)
+void CLR_RT_ExecutionEngine::InsertThreadRoundRobin(CLR_RT_Thread *thTarget)
 {
     NATIVE_PROFILE_CLR_CORE();
-    CLR_RT_Thread *th;
-
     thTarget->Unlink();
 
-    if (threads.IsEmpty())
-    {
-        th = (CLR_RT_Thread *)threads.Tail();
-    }
-    else
+    int band = thTarget->GetThreadPriority();
+
+    if (IsRealTimeThread(thTarget))
     {
-        int priTarget = thTarget->GetExecutionCounter();
+        band = c_ThreadReadyBand_RealTime;
 
-        NANOCLR_FOREACH_NODE__NODECL(CLR_RT_Thread, th, threads)
+        // preempt a thread of the other classes at its next IL safe point
+        if (m_currentThread != NULL && m_currentThread != thTarget && !IsRealTimeThread(m_currentThread))
         {
-            if (th->GetExecutionCounter() < priTarget)
-                break;
+            m_currentThread->m_timeQuantumExpired = true;
         }
-        NANOCLR_FOREACH_NODE_END();
     }
+    else if (band < ThreadPriority::Lowest)
+    {
+        band = ThreadPriority::Lowest;
+    }
+    else if (band > ThreadPriority::System_Highest)
+    {
+        band = ThreadPriority::System_Highest;
+    }
+
+    CLR_RT_DblLinkedList &threads = m_threadsReady[band];
+
+    // Each band is a FIFO, the list tail is the append point so insertion never walks the band.
+    // A thread with more credit than the band head (typically one woken from a wait) jumps to the head instead,
+    // so the head FirstReadyThread looks at normally carries the highest execution counter of the band.
+    CLR_RT_Thread *thHead = (CLR_RT_Thread *)threads.FirstNode();
+    bool fAtFront = thHead->Next() != NULL && thTarget->GetExecutionCounter() > thHead->GetExecutionCounter();
+
+    thTarget->m_readySequence = ++m_threadsReadySequence;
 
     thTarget->m_waitForEvents = 0;
     thTarget->m_waitForEvents_Timeout = TIMEOUT_INFINITE;
@@ -1440,7 +1806,132 @@ void CLR_RT_ExecutionEngine::InsertThreadRoundRobin(CLR_RT_DblLinkedList &thread
         thTarget->m_waitForObject = NULL;
     }
 
-    threads.InsertBeforeNode(th, thTarget);
+    if (fAtFront)
+    {
+        threads.LinkAtFront(thTarget);
+    }
+    else
+    {
+        threads.LinkAtBack(thTarget);
+    }
+
+    m_threadsReadyBands |= 1u << band;
+
+#if defined(NANOCLR_PROFILE_NEW_CALLS)
+    if (thTarget->m_readyTime == 0)
+    {
+        thTarget->m_readyTime = HAL_Time_CurrentTime();
+    }
+#endif
+}
+
+CLR_RT_Thread *CLR_RT_ExecutionEngine::FirstReadyThread()
+{
+    NATIVE_PROFILE_CLR_CORE();
+    CLR_RT_Thread *thBest = NULL;
+    int priBest = 0;
+
+    // Only the head of each band is a candidate, the highest execution counter wins.
+    // On a tie the thread that became ready first wins, as it did with a single ready list.
+    // A real-time thread is always picked ahead of the other classes.
+    for (int band = c_ThreadReadyBands - 1; band >= 0; band--)
+    {
+        if ((m_threadsReadyBands & (1u << band)) == 0)
+        {
+            continue;
+        }
+
+        CLR_RT_Thread *th = (CLR_RT_Thread *)m_threadsReady[band].FirstNode();
+
+        if (th->Next() == NULL)
+        {
+            // threads leave the ready lists by being linked elsewhere, so the bit is cleared lazily
+            m_threadsReadyBands &= ~(1u << band);
+            continue;
+        }
+
+        if (band == c_ThreadReadyBand_RealTime)
+        {
+            return th;
+        }
+
+        int pri = th->GetExecutionCounter();
+
+        if (thBest == NULL || pri > priBest ||
+            (pri == priBest && (CLR_INT32)(th->m_readySequence - thBest->m_readySequence) < 0))
+        {
+            thBest = th;
+            priBest = pri;
+        }
+    }
+
+    return thBest;
+}
+
+bool CLR_RT_ExecutionEngine::HasReadyThreads()
+{
+    NATIVE_PROFILE_CLR_CORE();
+    return FirstReadyThread() != NULL;
+}
+
+int CLR_RT_ExecutionEngine::NumOfReadyThreads()
+{
+    NATIVE_PROFILE_CLR_CORE();
+    int num = 0;
+
+    for (int band = 0; band < c_ThreadReadyBands; band++)
+    {
+        num += m_threadsReady[band].NumOfNodes();
+    }
+
+    return num;
+}
+
+void CLR_RT_ExecutionEngine::ConfigureScheduler(const CLR_SETTINGS &params)
+{
+    NATIVE_PROFILE_CLR_CORE();
+
+    m_timeQuantum_Milliseconds = params.ThreadQuantumMilliseconds;
+    m_timeQuantum_Milliseconds_RealTime = params.RealTimeThreadQuantumMilliseconds;
+    m_fHighestPriorityIsRealTime = params.HighestPriorityIsRealTime;
+}
+
+bool CLR_RT_ExecutionEngine::IsRealTimeThread(CLR_RT_Thread *th) const
+{
+    NATIVE_PROFILE_CLR_CORE();
+
+    return (th->m_flags & CLR_RT_Thread::TH_F_RealTime) != 0;
+}
+
+void CLR_RT_ExecutionEngine::UpdateSchedulingClass(CLR_RT_Thread *th)
+{
+    NATIVE_PROFILE_CLR_CORE();
+
+    // without the setting the flag is left to the native code that created the thread
+    if (m_fHighestPriorityIsRealTime)
+    {
+        if (th->GetThreadPriority() == ThreadPriority::Highest)
+        {
+            th->m_flags |= CLR_RT_Thread::TH_F_RealTime;
+        }
+        else
+        {
+            th->m_flags &= ~CLR_RT_Thread::TH_F_RealTime;
+        }
+    }
+}
+
+CLR_UINT32 CLR_RT_ExecutionEngine::GetTimeQuantum(CLR_RT_Thread *th) const
+{
+    NATIVE_PROFILE_CLR_CORE();
+
+    if (IsRealTimeThread(th))
+    {
+        return m_timeQuantum_Milliseconds_RealTime ? m_timeQuantum_Milliseconds_RealTime
+                                                   : CLR_RT_Thread::c_TimeQuantum_Milliseconds_RealTime;
+    }
+
+    return m_timeQuantum_Milliseconds ? m_timeQuantum_Milliseconds : CLR_RT_Thread::c_TimeQuantum_Milliseconds;
 }
 
 //--//
@@ -1458,6 +1949,8 @@ HRESULT CLR_RT_ExecutionEngine::NewThread(
     NANOCLR_CHECK_HRESULT(
         CLR_RT_Thread::CreateInstance(id != -1 ? id : ++m_lastPid, pDelegate, priority, thRes, flags));
 
+    UpdateSchedulingClass(thRes);
+
     PutInProperList(thRes);
 
     NANOCLR_CLEANUP();
@@ -2432,9 +2925,12 @@ CLR_RT_HeapBlock_Lock *CLR_RT_ExecutionEngine::FindLockObject(CLR_RT_HeapBlock &
         }
     }
 
-    lock = FindLockObject(m_threadsReady, object);
-    if (lock)
-        return lock;
+    for (int band = 0; band < c_ThreadReadyBands; band++)
+    {
+        lock = FindLockObject(m_threadsReady[band], object);
+        if (lock)
+            return lock;
+    }
     lock = FindLockObject(m_threadsWaiting, object);
     return lock;
 }
@@ -2446,7 +2942,10 @@ void CLR_RT_ExecutionEngine::DeleteLockRequests(CLR_RT_Thread *thTarget, CLR_RT_
     NATIVE_PROFILE_CLR_CORE();
     if ((thTarget && thTarget->m_lockRequestsCount) || (sthTarget && sthTarget->m_lockRequestsCount))
     {
-        DeleteLockRequests(thTarget, sthTarget, m_threadsReady);
+        for (int band = 0; band < c_ThreadReadyBands; band++)
+        {
+            DeleteLockRequests(thTarget, sthTarget, m_threadsReady[band]);
+        }
         DeleteLockRequests(thTarget, sthTarget, m_threadsWaiting);
     }
 }
@@ -2528,7 +3027,10 @@ CLR_INT64 CLR_RT_ExecutionEngine::ProcessTimer()
         {
             CheckTimers(timeoutMin);
 
-            CheckThreads(timeoutMin, m_threadsReady);
+            for (int band = 0; band < c_ThreadReadyBands; band++)
+            {
+                CheckThreads(timeoutMin, m_threadsReady[band]);
+            }
             CheckThreads(timeoutMin, m_threadsWaiting);
 
             m_timerCacheNextTimeout = timeoutMin + HAL_Time_CurrentTime();
@@ -2866,7 +3368,10 @@ void CLR_RT_ExecutionEngine::SignalEvents(CLR_UINT32 events)
 {
     NATIVE_PROFILE_CLR_CORE();
     // Why does the ready queue need to be checked.
-    SignalEvents(m_threadsReady, events);
+    for (int band = 0; band < c_ThreadReadyBands; band++)
+    {
+        SignalEvents(m_threadsReady[band], events);
+    }
     SignalEvents(m_threadsWaiting, events);
 }
 
@@ -3176,7 +3681,10 @@ void CLR_RT_ExecutionEngine::InstallBreakpoints(CLR_DBG_Commands::Debugging_Exec
 
     SetDebuggingInfoBreakpoints(true);
 
-    Breakpoint_Threads_Prepare(m_threadsReady);
+    for (int band = 0; band < c_ThreadReadyBands; band++)
+    {
+        Breakpoint_Threads_Prepare(m_threadsReady[band]);
+    }
     Breakpoint_Threads_Prepare(m_threadsWaiting);
 }
 
@@ -3750,7 +4258,10 @@ HRESULT CLR_RT_ExecutionEngine::UnloadAppDomain(CLR_RT_AppDomain *appDomain, CLR
     }
     NANOCLR_FOREACH_NODE_END();
 
-    PrepareThreadsForAppDomainUnload(appDomain, m_threadsReady);
+    for (int band = 0; band < c_ThreadReadyBands; band++)
+    {
+        PrepareThreadsForAppDomainUnload(appDomain, m_threadsReady[band]);
+    }
     PrepareThreadsForAppDomainUnload(appDomain, m_threadsWaiting);
 
     appDomain->m_state = CLR_RT_AppDomain::AppDomainState_Unloading;
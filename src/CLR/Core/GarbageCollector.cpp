@@ -404,7 +404,10 @@ void CLR_RT_GarbageCollector::Mark()
         //
         // Walk through all the stack frames, marking the objects as we dig down.
         //
-        Thread_Mark(g_CLR_RT_ExecutionEngine.m_threadsReady);
+        for (int band = 0; band < CLR_RT_ExecutionEngine::c_ThreadReadyBands; band++)
+        {
+            Thread_Mark(g_CLR_RT_ExecutionEngine.m_threadsReady[band]);
+        }
         Thread_Mark(g_CLR_RT_ExecutionEngine.m_threadsWaiting);
 
 #if !defined(NANOCLR_APPDOMAINS)
@@ -523,6 +526,9 @@ void CLR_RT_GarbageCollector::MarkWeak()
         }
     }
     NANOCLR_FOREACH_NODE_END();
+
+    g_CLR_RT_ExecutionEngine.IdentityHashCodes_Purge();
+    g_CLR_RT_ExecutionEngine.ReflectionCache_Purge();
 }
 
 //--//
@@ -821,11 +827,14 @@ void CLR_RT_GarbageCollector::RecoverEventsFromGC()
 
     //--//
 
-    NANOCLR_FOREACH_NODE(CLR_RT_Thread, th, g_CLR_RT_ExecutionEngine.m_threadsReady)
+    for (int band = 0; band < CLR_RT_ExecutionEngine::c_ThreadReadyBands; band++)
     {
-        th->RecoverFromGC();
+        NANOCLR_FOREACH_NODE(CLR_RT_Thread, th, g_CLR_RT_ExecutionEngine.m_threadsReady[band])
+        {
+            th->RecoverFromGC();
+        }
+        NANOCLR_FOREACH_NODE_END();
     }
-    NANOCLR_FOREACH_NODE_END();
 
     NANOCLR_FOREACH_NODE(CLR_RT_Thread, th, g_CLR_RT_ExecutionEngine.m_threadsWaiting)
     {
@@ -73,11 +73,14 @@ static void DumpTimeout(CLR_RT_Thread *th, CLR_INT64 &t)
 void CLR_RT_GarbageCollector::DumpThreads()
 {
     NATIVE_PROFILE_CLR_CORE();
-    NANOCLR_FOREACH_NODE(CLR_RT_Thread, th, g_CLR_RT_ExecutionEngine.m_threadsReady)
+    for (int band = 0; band < CLR_RT_ExecutionEngine::c_ThreadReadyBands; band++)
     {
-        th->DumpStack();
+        NANOCLR_FOREACH_NODE(CLR_RT_Thread, th, g_CLR_RT_ExecutionEngine.m_threadsReady[band])
+        {
+            th->DumpStack();
+        }
+        NANOCLR_FOREACH_NODE_END();
     }
-    NANOCLR_FOREACH_NODE_END();
 
     NANOCLR_FOREACH_NODE(CLR_RT_Thread, th, g_CLR_RT_ExecutionEngine.m_threadsWaiting)
     {
@@ -38,6 +38,9 @@ HRESULT CLR_HW_Hardware::Hardware_Initialize()
 
         m_interruptData.m_queuedInterrupts = 0;
 
+        m_interruptData.m_freeInterrupts.DblLinkedList_Initialize();
+        m_interruptData.m_freeInterruptsCount = 0;
+
         m_DebuggerEventsMask = 0;
 
 #if defined(NANOCLR_ENABLE_SOURCELEVELDEBUGGING)
@@ -81,6 +84,9 @@ void CLR_HW_Hardware::Hardware_Cleanup()
 void CLR_HW_Hardware::PrepareForGC()
 {
     NATIVE_PROFILE_CLR_HARDWARE();
+
+    // give the cached interrupt records back to the heap so they don't get in the way of compaction
+    ReleaseCachedInterrupts();
 }
 
 void CLR_HW_Hardware::ProcessActivity()
@@ -634,7 +634,7 @@ HRESULT CLR_RT_Thread::Execute()
     _ASSERTE(!CLR_EE_DBG_IS(Stopped));
 #endif // #if defined(NANOCLR_ENABLE_SOURCELEVELDEBUGGING)
 
-    ::Events_SetBoolTimer((bool *)&m_timeQuantumExpired, CLR_RT_Thread::c_TimeQuantum_Milliseconds);
+    ::Events_SetBoolTimer((bool *)&m_timeQuantumExpired, g_CLR_RT_ExecutionEngine.GetTimeQuantum(this));
 
     while (m_timeQuantumExpired == false && !CLR_EE_DBG_IS(Stopped))
     {
@@ -25,6 +25,55 @@ HRESULT CLR_HW_Hardware::ManagedHardware_Initialize()
     NANOCLR_NOCLEANUP_NOLABEL();
 }
 
+CLR_RT_ApplicationInterrupt* CLR_HW_Hardware::AllocateApplicationInterrupt()
+{
+    NATIVE_PROFILE_CLR_HARDWARE();
+
+    CLR_RT_ApplicationInterrupt* interrupt = (CLR_RT_ApplicationInterrupt*)m_interruptData.m_freeInterrupts.ExtractFirstNode();
+
+    if(interrupt != NULL)
+    {
+        --m_interruptData.m_freeInterruptsCount;
+
+        NANOCLR_CLEAR(*interrupt);
+
+        return interrupt;
+    }
+
+    return (CLR_RT_ApplicationInterrupt*)CLR_RT_Memory::Allocate_And_Erase( sizeof(CLR_RT_ApplicationInterrupt), CLR_RT_HeapBlock::HB_CompactOnFailure );
+}
+
+void CLR_HW_Hardware::ReleaseApplicationInterrupt( CLR_RT_ApplicationInterrupt* interrupt )
+{
+    NATIVE_PROFILE_CLR_HARDWARE();
+
+    // keep a few records around so bursts of interrupts don't hit the heap for each one of them
+    if(m_interruptData.m_freeInterruptsCount < c_MaxCachedInterrupts)
+    {
+        m_interruptData.m_freeInterrupts.LinkAtBack( interrupt );
+
+        ++m_interruptData.m_freeInterruptsCount;
+    }
+    else
+    {
+        CLR_RT_Memory::Release( interrupt );
+    }
+}
+
+void CLR_HW_Hardware::ReleaseCachedInterrupts()
+{
+    NATIVE_PROFILE_CLR_HARDWARE();
+
+    CLR_RT_ApplicationInterrupt* interrupt;
+
+    while(NULL != (interrupt = (CLR_RT_ApplicationInterrupt*)m_interruptData.m_freeInterrupts.ExtractFirstNode()))
+    {
+        CLR_RT_Memory::Release( interrupt );
+    }
+
+    m_interruptData.m_freeInterruptsCount = 0;
+}
+
 HRESULT CLR_HW_Hardware::SpawnDispatcher()
 {
     NATIVE_PROFILE_CLR_HARDWARE();
@@ -75,37 +124,65 @@ HRESULT CLR_HW_Hardware::TransferAllInterruptsToApplicationQueue()
 
     NANOCLR_HEADER();
 
-    while(true)
+    while(!m_interruptData.m_HalQueue.IsEmpty())
     {
-        HalInterruptRecord* rec;
-
+        CLR_RT_ApplicationInterrupt* batch[c_InterruptTransferBatch];
+        CLR_UINT32 pending = (CLR_UINT32)m_interruptData.m_HalQueue.NumberOfElements();
+        CLR_UINT32 allocated = 0;
+        CLR_UINT32 count = 0;
+
+        // read without the lock, it's only an estimate: the ISRs can add records meanwhile (picked up on the next
+        // round) or drop the oldest one (the spare record goes back to the cache)
+        if(pending == 0) pending = 1;
+        if(pending > c_InterruptTransferBatch) pending = c_InterruptTransferBatch;
+
+        // get the application records first, so a failed allocation leaves the HAL records in their queue
+        while(allocated < pending)
         {
-            GLOBAL_LOCK();
+            CLR_RT_ApplicationInterrupt* queueRec = AllocateApplicationInterrupt();
 
-            rec = m_interruptData.m_HalQueue.Peek();
+            if(queueRec == NULL) break;
 
-            GLOBAL_UNLOCK();
+            batch[allocated++] = queueRec;
         }
 
-        if(rec == NULL) break;
-
-        CLR_RT_ApplicationInterrupt* queueRec = (CLR_RT_ApplicationInterrupt*)CLR_RT_Memory::Allocate_And_Erase( sizeof(CLR_RT_ApplicationInterrupt), CLR_RT_HeapBlock::HB_CompactOnFailure );  CHECK_ALLOCATION(queueRec);
-
-        queueRec->m_interruptPortInterrupt.data1   =                                          rec->m_data1;
-        queueRec->m_interruptPortInterrupt.data2   =                                          rec->m_data2;
-        queueRec->m_interruptPortInterrupt.data3   =                                          rec->m_data3;
-        queueRec->m_interruptPortInterrupt.time    =                                          rec->m_time;
-        queueRec->m_interruptPortInterrupt.context = (CLR_RT_HeapBlock_NativeEventDispatcher*)rec->m_context;
-
-        m_interruptData.m_applicationQueue.LinkAtBack( queueRec ); ++m_interruptData.m_queuedInterrupts;
+        if(allocated == 0)
+        {
+            NANOCLR_SET_AND_LEAVE(CLR_E_OUT_OF_MEMORY);
+        }
 
+        // move a batch of records with a single lock, this also frees room in the HAL queue for the ISRs sooner
         {
             GLOBAL_LOCK();
 
-            m_interruptData.m_HalQueue.Pop();
+            HalInterruptRecord* rec;
+
+            while(count < allocated && (rec = m_interruptData.m_HalQueue.Pop()) != NULL)
+            {
+                CLR_RT_ApplicationInterrupt* queueRec = batch[count++];
+
+                queueRec->m_interruptPortInterrupt.data1   =                                          rec->m_data1;
+                queueRec->m_interruptPortInterrupt.data2   =                                          rec->m_data2;
+                queueRec->m_interruptPortInterrupt.data3   =                                          rec->m_data3;
+                queueRec->m_interruptPortInterrupt.time    =                                          rec->m_time;
+                queueRec->m_interruptPortInterrupt.context = (CLR_RT_HeapBlock_NativeEventDispatcher*)rec->m_context;
+            }
 
             GLOBAL_UNLOCK();
         }
+
+        for(CLR_UINT32 i = 0; i < count; i++)
+        {
+            m_interruptData.m_applicationQueue.LinkAtBack( batch[i] ); ++m_interruptData.m_queuedInterrupts;
+        }
+
+        // the queue drained while we were allocating, give back the records we didn't need
+        for(CLR_UINT32 i = count; i < allocated; i++)
+        {
+            ReleaseApplicationInterrupt( batch[i] );
+        }
+
+        if(count < allocated) break;
     }
 
     if(m_interruptData.m_queuedInterrupts == 0)
@@ -26,6 +26,23 @@ __nfweak HRESULT CLR_HW_Hardware::TransferAllInterruptsToApplicationQueue()
     NANOCLR_SYSTEM_STUB_RETURN();
 }
 
+__nfweak CLR_RT_ApplicationInterrupt* CLR_HW_Hardware::AllocateApplicationInterrupt()
+{
+    NATIVE_PROFILE_CLR_HARDWARE();
+    return (CLR_RT_ApplicationInterrupt*)CLR_RT_Memory::Allocate_And_Erase( sizeof(CLR_RT_ApplicationInterrupt), CLR_RT_HeapBlock::HB_CompactOnFailure );
+}
+
+__nfweak void CLR_HW_Hardware::ReleaseApplicationInterrupt( CLR_RT_ApplicationInterrupt* interrupt )
+{
+    NATIVE_PROFILE_CLR_HARDWARE();
+    CLR_RT_Memory::Release( interrupt );
+}
+
+__nfweak void CLR_HW_Hardware::ReleaseCachedInterrupts()
+{
+    NATIVE_PROFILE_CLR_HARDWARE();
+}
+
 __nfweak HRESULT CLR_HW_Hardware::ProcessInterrupts()
 {
     NATIVE_PROFILE_CLR_HARDWARE();
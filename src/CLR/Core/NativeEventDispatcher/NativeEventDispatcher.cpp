@@ -277,7 +277,7 @@ void CLR_RT_HeapBlock_NativeEventDispatcher::ThreadTerminationCallback(void *arg
     interrupt.data1 = 0;
     interrupt.data2 = 0;
 
-    CLR_RT_Memory::Release(appInterrupt);
+    g_CLR_HW_Hardware.ReleaseApplicationInterrupt(appInterrupt);
 
     g_CLR_HW_Hardware.SpawnDispatcher();
 }
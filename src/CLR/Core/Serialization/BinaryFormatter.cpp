@@ -1606,6 +1606,12 @@ HRESULT CLR_RT_BinaryFormatter::State::Advance()
                     m_fields_CurrentClass = m_value.m_type->m_handlerCls;
                     m_fields_CurrentField = 0;
                     m_fields_Pointer = NULL;
+
+                    // enum fields take the hints of the value, not their own, so they don't use a plan
+                    if ((m_value.m_type->m_flags & CLR_RT_DataTypeLookup::c_Enum) == 0)
+                    {
+                        NANOCLR_CHECK_HRESULT(m_parent->GetTypePlan(m_fields_CurrentClass, m_fields_Plan));
+                    }
                     break;
                 }
 
@@ -1663,6 +1669,20 @@ HRESULT CLR_RT_BinaryFormatter::State::AdvanceToTheNextField()
     NATIVE_PROFILE_CLR_SERIALIZATION();
     NANOCLR_HEADER();
 
+    if (m_fields_Plan)
+    {
+        if (m_fields_CurrentField < m_fields_Plan->m_numFields)
+        {
+            FieldPlan &field = m_fields_Plan->m_fields[m_fields_CurrentField++];
+
+            m_fields_Pointer = m_value.m_value->Dereference() + field.m_offset;
+
+            NANOCLR_SET_AND_LEAVE(State::CreateInstance(m_parent, &field.m_hints, &field.m_desc));
+        }
+
+        NANOCLR_SET_AND_LEAVE(SetValueAndDestroyInstance());
+    }
+
     while (NANOCLR_INDEX_IS_VALID(m_fields_CurrentClass))
     {
         if (m_fields_CurrentField < m_fields_CurrentClass.m_target->iFields_Num)
@@ -1787,9 +1807,10 @@ HRESULT CLR_RT_BinaryFormatter::CreateInstance(CLR_UINT8 *buf, int len, CLR_RT_B
     ptr->m_stream = NULL;    // CLR_RT_HeapBlock_MemoryStream* m_stream;
     ptr->m_idx = 0;          // CLR_UINT32                     m_idx;
     ptr->m_lastTypeRead = 0; // CLR_UINT32                     m_lastTypeRead;
-    ptr->m_duplicates
-        .DblLinkedList_Initialize(); // CLR_RT_DblLinkedList           m_duplicates;            // EVENT HEAP - NO
-                                     // RELOCATION - list of CLR_RT_BinaryFormatter::DuplicateTracker
+    ptr->m_duplicates = NULL;     // CLR_RT_HeapBlock**             m_duplicates;
+    ptr->m_duplicatesHash = NULL; // CLR_UINT32*                    m_duplicatesHash;
+    ptr->m_duplicatesSize = 0;    // CLR_UINT32                     m_duplicatesSize;
+    ptr->m_plans = NULL;          // TypePlan*                      m_plans;
     ptr->m_states.DblLinkedList_Initialize(); // CLR_RT_DblLinkedList           m_states;                // EVENT HEAP -
                                               // NO RELOCATION - list of CLR_RT_BinaryFormatter::State
                                               //
@@ -1806,7 +1827,25 @@ void CLR_RT_BinaryFormatter::DestroyInstance()
 {
     NATIVE_PROFILE_CLR_SERIALIZATION();
     m_states.DblLinkedList_PushToCache();
-    m_duplicates.DblLinkedList_PushToCache();
+
+    if (m_duplicates)
+    {
+        CLR_RT_Memory::Release(m_duplicates);
+    }
+
+    if (m_duplicatesHash)
+    {
+        CLR_RT_Memory::Release(m_duplicatesHash);
+    }
+
+    while (m_plans)
+    {
+        TypePlan *next = m_plans->m_next;
+
+        CLR_RT_Memory::Release(m_plans);
+
+        m_plans = next;
+    }
 
     CLR_RT_HeapBlock_MemoryStream::DeleteInstance(m_stream);
 
@@ -1832,6 +1871,93 @@ HRESULT CLR_RT_BinaryFormatter::Advance()
 
 //--//
 
+HRESULT CLR_RT_BinaryFormatter::GetTypePlan(const CLR_RT_TypeDef_Index &cls, TypePlan *&plan)
+{
+    NATIVE_PROFILE_CLR_SERIALIZATION();
+    NANOCLR_HEADER();
+
+    CLR_RT_TypeDef_Instance inst{};
+    CLR_RT_FieldDef_Instance field{};
+    CLR_RT_FieldDef_Index idx;
+    int numFields = 0;
+
+    for (plan = m_plans; plan; plan = plan->m_next)
+    {
+        if (plan->m_cls.m_data == cls.m_data)
+        {
+            NANOCLR_SET_AND_LEAVE(S_OK);
+        }
+    }
+
+    // same walk as AdvanceToTheNextField, first to size the plan and then to fill it
+    inst.InitializeFromIndex(cls);
+
+    while (NANOCLR_INDEX_IS_VALID(inst))
+    {
+        for (int i = 0; i < inst.m_target->iFields_Num; i++)
+        {
+            idx.Set(inst.Assembly(), inst.m_target->iFields_First + i);
+            field.InitializeFromIndex(idx);
+
+            if ((field.m_target->flags & CLR_RECORD_FIELDDEF::FD_NotSerialized) == 0)
+            {
+                numFields++;
+            }
+        }
+
+        inst.SwitchToParent();
+    }
+
+    plan = (TypePlan *)CLR_RT_Memory::Allocate(
+        sizeof(TypePlan) + (numFields > 0 ? numFields - 1 : 0) * sizeof(FieldPlan));
+    CHECK_ALLOCATION(plan);
+
+    plan->m_cls = cls;
+    plan->m_numFields = 0;
+
+    inst.InitializeFromIndex(cls);
+
+    while (NANOCLR_INDEX_IS_VALID(inst))
+    {
+        for (int i = 0; i < inst.m_target->iFields_Num; i++)
+        {
+            idx.Set(inst.Assembly(), inst.m_target->iFields_First + i);
+            field.InitializeFromIndex(idx);
+
+            if ((field.m_target->flags & CLR_RECORD_FIELDDEF::FD_NotSerialized) == 0)
+            {
+                FieldPlan &dst = plan->m_fields[plan->m_numFields];
+
+                dst.m_offset = field.CrossReference().m_offset;
+                dst.m_desc.TypeDescriptor_Initialize();
+
+                NANOCLR_CHECK_HRESULT(State::FindHints(dst.m_hints, field));
+                NANOCLR_CHECK_HRESULT(dst.m_desc.InitializeFromFieldDefinition(field));
+
+                plan->m_numFields++;
+            }
+        }
+
+        inst.SwitchToParent();
+    }
+
+    plan->m_next = m_plans;
+    m_plans = plan;
+
+    NANOCLR_CLEANUP();
+
+    if (FAILED(hr) && plan)
+    {
+        CLR_RT_Memory::Release(plan);
+
+        plan = NULL;
+    }
+
+    NANOCLR_CLEANUP_END();
+}
+
+//--//
+
 void CLR_RT_BinaryFormatter::PrepareForGC(void *data)
 {
     NATIVE_PROFILE_CLR_SERIALIZATION();
@@ -1846,6 +1972,11 @@ void CLR_RT_BinaryFormatter::PrepareForGC(void *data)
             g_CLR_RT_GarbageCollector.CheckSingleBlock_Force(state->m_value.m_value);
         }
         NANOCLR_FOREACH_NODE_END();
+
+        for (CLR_UINT32 i = 0; i < bf->m_idx; i++)
+        {
+            g_CLR_RT_GarbageCollector.CheckSingleBlock_Force(bf->m_duplicates[i]);
+        }
     }
 }
 
@@ -1988,54 +2119,152 @@ HRESULT CLR_RT_BinaryFormatter::Deserialize(
 
 //--//
 
-HRESULT CLR_RT_BinaryFormatter::TrackDuplicate(CLR_RT_HeapBlock *object)
+static inline CLR_UINT32 DuplicateHash(CLR_RT_HeapBlock *object)
+{
+    // heap blocks are at least 8 bytes apart, drop the bits that never change and mix the rest
+    CLR_UINT32 hash = (CLR_UINT32)(size_t)object >> 3;
+
+    hash ^= hash >> 16;
+    hash *= 0x9E3779B1;
+    hash ^= hash >> 15;
+
+    return hash;
+}
+
+HRESULT CLR_RT_BinaryFormatter::GrowDuplicates()
 {
     NATIVE_PROFILE_CLR_SERIALIZATION();
     NANOCLR_HEADER();
 
-    DuplicateTracker *ptr =
-        EVENTCACHE_EXTRACT_NODE(g_CLR_RT_EventCache, DuplicateTracker, DATATYPE_SERIALIZER_DUPLICATE);
+    CLR_UINT32 size = m_duplicatesSize ? m_duplicatesSize * 2 : c_Duplicates_InitialSize;
+    CLR_RT_HeapBlock **duplicates;
+    CLR_UINT32 *hashTable = NULL;
 
-    CHECK_ALLOCATION(ptr);
+    duplicates = (CLR_RT_HeapBlock **)CLR_RT_Memory::Allocate(size * sizeof(CLR_RT_HeapBlock *));
+    CHECK_ALLOCATION(duplicates);
 
-    m_duplicates.LinkAtBack(ptr);
+    // the lookup by address is only needed when emitting, the reader resolves duplicates by id
+    if (!m_fDeserialize)
+    {
+        hashTable = (CLR_UINT32 *)CLR_RT_Memory::Allocate_And_Erase(2 * size * sizeof(CLR_UINT32));
+
+        if (hashTable == NULL)
+        {
+            CLR_RT_Memory::Release(duplicates);
 
-    ptr->m_ptr = TypeHandler::FixDereference(object);
-    ptr->m_idx = m_idx++;
+            NANOCLR_SET_AND_LEAVE(CLR_E_OUT_OF_MEMORY);
+        }
+    }
+
+    if (m_duplicates)
+    {
+        memcpy(duplicates, m_duplicates, m_idx * sizeof(CLR_RT_HeapBlock *));
+
+        CLR_RT_Memory::Release(m_duplicates);
+    }
+
+    if (m_duplicatesHash)
+    {
+        CLR_RT_Memory::Release(m_duplicatesHash);
+    }
+
+    m_duplicates = duplicates;
+    m_duplicatesHash = hashTable;
+    m_duplicatesSize = size;
+
+    if (hashTable)
+    {
+        CLR_UINT32 mask = 2 * size - 1;
+
+        for (CLR_UINT32 idx = 0; idx < m_idx; idx++)
+        {
+            CLR_UINT32 slot = DuplicateHash(duplicates[idx]) & mask;
+
+            while (hashTable[slot])
+            {
+                slot = (slot + 1) & mask;
+            }
+
+            hashTable[slot] = idx + 1;
+        }
+    }
 
     NANOCLR_NOCLEANUP();
 }
 
-CLR_UINT32 CLR_RT_BinaryFormatter::SearchDuplicate(CLR_RT_HeapBlock *object)
+HRESULT CLR_RT_BinaryFormatter::TrackDuplicate(CLR_RT_HeapBlock *object)
 {
     NATIVE_PROFILE_CLR_SERIALIZATION();
+    NANOCLR_HEADER();
+
+    if (m_idx == m_duplicatesSize)
+    {
+        NANOCLR_CHECK_HRESULT(GrowDuplicates());
+    }
+
     object = TypeHandler::FixDereference(object);
 
-    NANOCLR_FOREACH_NODE(DuplicateTracker, ptr, m_duplicates)
+    m_duplicates[m_idx] = object;
+
+    if (m_duplicatesHash)
     {
-        if (ptr->m_ptr == object)
+        // the table is never more than half full, so there is always a free bucket
+        CLR_UINT32 mask = 2 * m_duplicatesSize - 1;
+        CLR_UINT32 slot = DuplicateHash(object) & mask;
+
+        while (m_duplicatesHash[slot])
         {
-            return ptr->m_idx;
+            slot = (slot + 1) & mask;
         }
+
+        m_duplicatesHash[slot] = m_idx + 1;
     }
-    NANOCLR_FOREACH_NODE_END();
 
-    return (CLR_UINT32)-1;
+    m_idx++;
+
+    NANOCLR_NOCLEANUP();
 }
 
-CLR_RT_HeapBlock *CLR_RT_BinaryFormatter::GetDuplicate(CLR_UINT32 idx)
+CLR_UINT32 CLR_RT_BinaryFormatter::SearchDuplicate(CLR_RT_HeapBlock *object)
 {
     NATIVE_PROFILE_CLR_SERIALIZATION();
-    NANOCLR_FOREACH_NODE(DuplicateTracker, ptr, m_duplicates)
+    object = TypeHandler::FixDereference(object);
+
+    if (m_duplicatesHash)
+    {
+        CLR_UINT32 mask = 2 * m_duplicatesSize - 1;
+        CLR_UINT32 slot = DuplicateHash(object) & mask;
+        CLR_UINT32 entry;
+
+        while ((entry = m_duplicatesHash[slot]) != 0)
+        {
+            if (m_duplicates[entry - 1] == object)
+            {
+                return entry - 1;
+            }
+
+            slot = (slot + 1) & mask;
+        }
+    }
+    else
     {
-        if (ptr->m_idx == idx)
+        for (CLR_UINT32 idx = 0; idx < m_idx; idx++)
         {
-            return ptr->m_ptr;
+            if (m_duplicates[idx] == object)
+            {
+                return idx;
+            }
         }
     }
-    NANOCLR_FOREACH_NODE_END();
 
-    return NULL;
+    return (CLR_UINT32)-1;
+}
+
+CLR_RT_HeapBlock *CLR_RT_BinaryFormatter::GetDuplicate(CLR_UINT32 idx)
+{
+    NATIVE_PROFILE_CLR_SERIALIZATION();
+
+    return idx < m_idx ? m_duplicates[idx] : NULL;
 }
 
 //--//--//
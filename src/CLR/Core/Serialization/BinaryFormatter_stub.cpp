@@ -356,6 +356,21 @@ __nfweak CLR_RT_HeapBlock *CLR_RT_BinaryFormatter::GetDuplicate(CLR_UINT32 idx)
     return NULL;
 }
 
+__nfweak HRESULT CLR_RT_BinaryFormatter::GrowDuplicates()
+{
+    NATIVE_PROFILE_CLR_SERIALIZATION();
+    NANOCLR_FEATURE_STUB_RETURN();
+}
+
+__nfweak HRESULT CLR_RT_BinaryFormatter::GetTypePlan(const CLR_RT_TypeDef_Index &cls, TypePlan *&plan)
+{
+    (void)cls;
+    (void)plan;
+
+    NATIVE_PROFILE_CLR_SERIALIZATION();
+    NANOCLR_FEATURE_STUB_RETURN();
+}
+
 //--//--//
 
 __nfweak int CLR_RT_BinaryFormatter::BitsAvailable()
@@ -213,6 +213,10 @@ HRESULT CLR_RT_Thread::CreateInstance(int pid, int priority, CLR_RT_Thread *&th,
         th->m_flags = flags;                             // CLR_UINT32                 m_flags;
         th->m_executionCounter = 0;                      // int                        m_executionCounter;
         th->m_timeQuantumExpired = false;                // bool                       m_timeQuantumExpired;
+        th->m_readySequence = 0;                         // CLR_UINT32                 m_readySequence;
+#if defined(NANOCLR_PROFILE_NEW_CALLS)
+        th->m_readyTime = 0; // CLR_INT64                  m_readyTime;
+#endif
                                                          //
         th->m_dlg = NULL;                                // CLR_RT_HeapBlock_Delegate* m_dlg;
         th->m_currentException.SetObjectReference(NULL); // CLR_RT_HeapBlock           m_currentException;
@@ -220,12 +220,15 @@ CLR_RT_AppDomain *CLR_DBG_Debugger::GetAppDomainFromID(CLR_UINT32 id)
 CLR_RT_Thread *CLR_DBG_Debugger::GetThreadFromPid(CLR_INT32 pid)
 {
     NATIVE_PROFILE_CLR_DEBUGGER();
-    NANOCLR_FOREACH_NODE(CLR_RT_Thread, th, g_CLR_RT_ExecutionEngine.m_threadsReady)
+    for (int band = 0; band < CLR_RT_ExecutionEngine::c_ThreadReadyBands; band++)
     {
-        if (th->m_pid == pid)
-            return th;
+        NANOCLR_FOREACH_NODE(CLR_RT_Thread, th, g_CLR_RT_ExecutionEngine.m_threadsReady[band])
+        {
+            if (th->m_pid == pid)
+                return th;
+        }
+        NANOCLR_FOREACH_NODE_END();
     }
-    NANOCLR_FOREACH_NODE_END();
 
     NANOCLR_FOREACH_NODE(CLR_RT_Thread, th, g_CLR_RT_ExecutionEngine.m_threadsWaiting)
     {
@@ -245,7 +248,7 @@ HRESULT CLR_DBG_Debugger::CreateListOfThreads(CLR_DBG_Commands::Debugging_Thread
     CLR_UINT32 *pidDst;
     int num;
 
-    num = g_CLR_RT_ExecutionEngine.m_threadsReady.NumOfNodes() + g_CLR_RT_ExecutionEngine.m_threadsWaiting.NumOfNodes();
+    num = g_CLR_RT_ExecutionEngine.NumOfReadyThreads() + g_CLR_RT_ExecutionEngine.m_threadsWaiting.NumOfNodes();
 
     totLen = sizeof(*cmdReply) + (num - 1) * sizeof(CLR_UINT32);
 
@@ -256,11 +259,14 @@ HRESULT CLR_DBG_Debugger::CreateListOfThreads(CLR_DBG_Commands::Debugging_Thread
 
     pidDst = cmdReply->m_pids;
 
-    NANOCLR_FOREACH_NODE(CLR_RT_Thread, thSrc, g_CLR_RT_ExecutionEngine.m_threadsReady)
+    for (int band = 0; band < CLR_RT_ExecutionEngine::c_ThreadReadyBands; band++)
     {
-        *pidDst++ = thSrc->m_pid;
+        NANOCLR_FOREACH_NODE(CLR_RT_Thread, thSrc, g_CLR_RT_ExecutionEngine.m_threadsReady[band])
+        {
+            *pidDst++ = thSrc->m_pid;
+        }
+        NANOCLR_FOREACH_NODE_END();
     }
-    NANOCLR_FOREACH_NODE_END();
 
     NANOCLR_FOREACH_NODE(CLR_RT_Thread, thSrc, g_CLR_RT_ExecutionEngine.m_threadsWaiting)
     {
@@ -452,6 +452,15 @@ __nfweak HRESULT CLR_PRF_Profiler::RecordContextSwitch(CLR_RT_Thread* nextThread
     return S_OK;
 }
 
+__nfweak HRESULT CLR_PRF_Profiler::RecordSchedulingLatency(CLR_RT_Thread* th, CLR_INT64 latency)
+{
+    (void)th;
+    (void)latency;
+
+    NATIVE_PROFILE_CLR_DIAGNOSTICS();
+    return S_OK;
+}
+
 __nfweak HRESULT CLR_PRF_Profiler::RecordFunctionCall(CLR_RT_Thread* th, CLR_RT_MethodDef_Index md)
 {
     (void)th;
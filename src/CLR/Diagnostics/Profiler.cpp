@@ -195,10 +195,14 @@ HRESULT CLR_PRF_Profiler::DumpRoots()
     NANOCLR_FOREACH_ASSEMBLY_END();
 
     { // Iterate through all threads.
-        CLR_RT_DblLinkedList *threadLists[2] = {
-            &g_CLR_RT_ExecutionEngine.m_threadsReady,
-            &g_CLR_RT_ExecutionEngine.m_threadsWaiting};
-        for (int list = 0; list < 2; list++)
+        CLR_RT_DblLinkedList *threadLists[CLR_RT_ExecutionEngine::c_ThreadReadyBands + 1];
+        for (int band = 0; band < CLR_RT_ExecutionEngine::c_ThreadReadyBands; band++)
+        {
+            threadLists[band] = &g_CLR_RT_ExecutionEngine.m_threadsReady[band];
+        }
+        threadLists[CLR_RT_ExecutionEngine::c_ThreadReadyBands] = &g_CLR_RT_ExecutionEngine.m_threadsWaiting;
+
+        for (int list = 0; list < CLR_RT_ExecutionEngine::c_ThreadReadyBands + 1; list++)
         {
             NANOCLR_FOREACH_NODE(CLR_RT_Thread, th, *threadLists[list])
             {
@@ -622,6 +626,31 @@ HRESULT CLR_PRF_Profiler::RecordContextSwitch(CLR_RT_Thread *nextThread)
     NANOCLR_NOCLEANUP();
 }
 
+HRESULT CLR_PRF_Profiler::RecordSchedulingLatency(CLR_RT_Thread *th, CLR_INT64 latency)
+{
+    NATIVE_PROFILE_CLR_DIAGNOSTICS();
+    NANOCLR_HEADER();
+    _ASSERTE(th);
+
+#ifdef NANOCLR_FORCE_PROFILER_EXECUTION
+    if (g_CLR_PRF_Profiler.m_initialized)
+#else
+    if (CLR_EE_PRF_IS(Calls))
+#endif
+    {
+        CLR_PROF_HANDLER_CALLCHAIN_VOID(perf);
+
+        // time from entering the ready queue to being dispatched, same units as the call timings
+        Timestamp();
+        m_stream->WriteBits(CLR_PRF_CMDS::c_Profiling_Calls_SchedulingLatency, CLR_PRF_CMDS::Bits::CommandHeader);
+        PackAndWriteBits(th->m_pid);
+        PackAndWriteBits((CLR_UINT32)(latency >> CLR_PRF_CMDS::Bits::CallTimingShift));
+        NANOCLR_CHECK_HRESULT(Stream_Send());
+    }
+
+    NANOCLR_NOCLEANUP();
+}
+
 HRESULT CLR_PRF_Profiler::RecordFunctionCall(CLR_RT_Thread *th, CLR_RT_MethodDef_Index md)
 {
     NATIVE_PROFILE_CLR_DIAGNOSTICS();
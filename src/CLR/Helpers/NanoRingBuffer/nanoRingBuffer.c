@@ -5,26 +5,60 @@
 
 #include "nanoRingBuffer.h"
 
+// the producer owns _write_index and the consumer owns _read_index
+// loading the other side's index with acquire semantics and publishing our own with release semantics
+// guarantees that the data copied to/from the buffer is visible before the index update
+#if defined(__GNUC__) || defined(__clang__)
+#define RINGBUFFER_LOAD_ACQUIRE(index)         __atomic_load_n(&(index), __ATOMIC_ACQUIRE)
+#define RINGBUFFER_STORE_RELEASE(index, value) __atomic_store_n(&(index), (value), __ATOMIC_RELEASE)
+#else
+#define RINGBUFFER_LOAD_ACQUIRE(index)         (*(volatile size_t *)&(index))
+#define RINGBUFFER_STORE_RELEASE(index, value) (*(volatile size_t *)&(index) = (value))
+#endif
+
+// indexes run over [0, 2 * capacity), advancing never goes over one lap so a subtraction is enough to wrap them
+static inline size_t WrapIndex(NanoRingBuffer *object, size_t index)
+{
+    return index >= 2 * object->_capacity ? index - 2 * object->_capacity : index;
+}
+
+// offset in the storage buffer for an index
+static inline size_t IndexToOffset(NanoRingBuffer *object, size_t index)
+{
+    return index >= object->_capacity ? index - object->_capacity : index;
+}
+
+static inline size_t UsedSpace(NanoRingBuffer *object, size_t writeIndex, size_t readIndex)
+{
+    return writeIndex >= readIndex ? writeIndex - readIndex : 2 * object->_capacity + writeIndex - readIndex;
+}
+
 void OptimizeSequence(NanoRingBuffer *object)
 {
-    // no elements, so there is nothing to optimize
-    if (object->_size == 0)
+    size_t size = NanoRingBuffer_Size(object);
+    size_t readOffset = IndexToOffset(object, object->_read_index);
+
+    // no elements, just reset the indexes
+    if (size == 0)
     {
+        object->_read_index = 0;
+        object->_write_index = 0;
+
         return;
     }
 
     // read index is already at index 0, so there is nothing to optimize
-    if (object->_read_index == 0)
+    if (readOffset == 0)
     {
         return;
     }
 
-    // can move data in a single memcpy
-    if (object->_read_index < object->_write_index)
+    // can move data in a single memmove
+    if (size <= object->_capacity - readOffset)
     {
         // buffer looks like this
         // |...xxxxx.....|
-        memcpy(object->_buffer, object->_buffer + object->_read_index, object->_size);
+        memmove(object->_buffer, object->_buffer + readOffset, size);
     }
     // need to move data in two steps
     else
@@ -32,19 +66,24 @@ void OptimizeSequence(NanoRingBuffer *object)
         // buffer looks like this
         // |xxxx......xxxxxx|
 
-        // store size of tail
-        size_t tailSize = object->_write_index - sizeof(uint8_t);
+        // store size of tail (the part that wrapped to the start of the buffer)
+        size_t tailSize = size - (object->_capacity - readOffset);
 
         // 1st move tail to temp buffer (need to malloc first)
         uint8_t *tempBuffer = (uint8_t *)platform_malloc(tailSize);
 
+        if (tempBuffer == NULL)
+        {
+            return;
+        }
+
         memcpy(tempBuffer, object->_buffer, tailSize);
 
         // store size of remaining buffer
-        size_t headSize = object->_capacity - object->_read_index;
+        size_t headSize = object->_capacity - readOffset;
 
         // 2nd move head to start of buffer
-        memcpy(object->_buffer, object->_buffer + object->_read_index, headSize);
+        memmove(object->_buffer, object->_buffer + readOffset, headSize);
 
         // 3rd move temp buffer after head
         memcpy(object->_buffer + headSize, tempBuffer, tailSize);
@@ -55,7 +94,7 @@ void OptimizeSequence(NanoRingBuffer *object)
 
     // adjust indexes
     object->_read_index = 0;
-    object->_write_index = object->_size;
+    object->_write_index = size;
 }
 
 void NanoRingBuffer_Initialize(NanoRingBuffer *object, uint8_t *buffer, size_t size)
@@ -63,7 +102,6 @@ void NanoRingBuffer_Initialize(NanoRingBuffer *object, uint8_t *buffer, size_t s
     object->_capacity = size;
     object->_write_index = 0;
     object->_read_index = 0;
-    object->_size = 0;
 
     object->_buffer = buffer;
 }
@@ -75,235 +113,156 @@ size_t NanoRingBuffer_Capacity(NanoRingBuffer *object)
 
 size_t NanoRingBuffer_Size(NanoRingBuffer *object)
 {
-    return object->_size;
+    return UsedSpace(
+        object,
+        RINGBUFFER_LOAD_ACQUIRE(object->_write_index),
+        RINGBUFFER_LOAD_ACQUIRE(object->_read_index));
 }
 
-size_t NanoRingBuffer_Push(NanoRingBuffer *object, const uint8_t data)
+size_t NanoRingBuffer_Free(NanoRingBuffer *object)
 {
-    // check for buffer full
-    if (object->_size == object->_capacity)
-    {
-        // buffer full
-        return 0;
-    }
-
-    uint8_t *destination = object->_buffer;
-    destination += object->_write_index;
+    return object->_capacity - NanoRingBuffer_Size(object);
+}
 
-    *destination = data;
-    object->_write_index++;
+uint8_t *NanoRingBuffer_PeekWrite(NanoRingBuffer *object, size_t *length)
+{
+    size_t writeIndex = object->_write_index;
+    size_t freeSpace =
+        object->_capacity - UsedSpace(object, writeIndex, RINGBUFFER_LOAD_ACQUIRE(object->_read_index));
+    size_t writeOffset = IndexToOffset(object, writeIndex);
 
-    // check if we are the end of the capacity
-    if (object->_write_index == object->_capacity)
+    // the region can't go past the end of the storage buffer
+    if (freeSpace > object->_capacity - writeOffset)
     {
-        object->_write_index = 0;
+        freeSpace = object->_capacity - writeOffset;
     }
 
-    // update ring buffer size
-    object->_size++;
+    *length = freeSpace;
+
+    return object->_buffer + writeOffset;
+}
 
-    ASSERT(object->_write_index <= object->_capacity);
-    ASSERT(object->_size <= object->_capacity);
+void NanoRingBuffer_CommitWrite(NanoRingBuffer *object, size_t length)
+{
+    ASSERT(length <= NanoRingBuffer_Free(object));
 
-    return 1;
+    RINGBUFFER_STORE_RELEASE(object->_write_index, WrapIndex(object, object->_write_index + length));
 }
 
-size_t NanoRingBuffer_PushN(NanoRingBuffer *object, const uint8_t *data, size_t length)
+const uint8_t *NanoRingBuffer_PeekRead(NanoRingBuffer *object, size_t *length)
 {
-    size_t lengthToWrite = 0;
+    size_t readIndex = object->_read_index;
+    size_t usedSpace = UsedSpace(object, RINGBUFFER_LOAD_ACQUIRE(object->_write_index), readIndex);
+    size_t readOffset = IndexToOffset(object, readIndex);
 
-    // sanity check for 0 length
-    if (length == 0)
+    // the region can't go past the end of the storage buffer
+    if (usedSpace > object->_capacity - readOffset)
     {
-        return 0;
+        usedSpace = object->_capacity - readOffset;
     }
 
+    *length = usedSpace;
+
+    return object->_buffer + readOffset;
+}
+
+size_t NanoRingBuffer_Push(NanoRingBuffer *object, const uint8_t data)
+{
+    size_t length;
+    uint8_t *destination = NanoRingBuffer_PeekWrite(object, &length);
+
     // check for buffer full
-    if (object->_size == object->_capacity)
+    if (length == 0)
     {
         // buffer full
         return 0;
     }
 
-    if (length <= (object->_capacity - object->_size))
-    {
-        lengthToWrite = length;
-    }
-    else
-    {
-        lengthToWrite = (object->_capacity - object->_size);
-    }
+    *destination = data;
+
+    NanoRingBuffer_CommitWrite(object, 1);
+
+    return 1;
+}
 
-    uint8_t *destination = object->_buffer;
-    destination += object->_write_index;
+size_t NanoRingBuffer_PushN(NanoRingBuffer *object, const uint8_t *data, size_t length)
+{
+    size_t lengthWritten = 0;
 
-    // single memcpy
-    if (lengthToWrite <= object->_capacity - object->_write_index)
+    // at most two chunks: up to the end of the storage buffer and then from its start
+    while (lengthWritten < length)
     {
-        memcpy(destination, data, lengthToWrite);
-        object->_write_index += lengthToWrite;
+        size_t chunkSize;
+        uint8_t *destination = NanoRingBuffer_PeekWrite(object, &chunkSize);
 
-        // check if we are the end of the capacity
-        if (object->_write_index == object->_capacity)
+        // check for buffer full
+        if (chunkSize == 0)
         {
-            object->_write_index = 0;
+            break;
         }
-    }
-    // need to memcpy in two chunks
-    else
-    {
-        size_t chunk1Size = object->_capacity - object->_write_index;
-        memcpy(destination, data, chunk1Size);
 
-        data += chunk1Size;
-
-        size_t chunk2Size = lengthToWrite - chunk1Size;
-        memcpy(object->_buffer, data, chunk2Size);
+        if (chunkSize > length - lengthWritten)
+        {
+            chunkSize = length - lengthWritten;
+        }
 
-        object->_write_index = chunk2Size;
-    }
+        memcpy(destination, data + lengthWritten, chunkSize);
 
-    // update ring buffer size
-    object->_size += lengthToWrite;
+        NanoRingBuffer_CommitWrite(object, chunkSize);
 
-    ASSERT(object->_write_index <= object->_capacity);
-    ASSERT(object->_size <= object->_capacity);
+        lengthWritten += chunkSize;
+    }
 
-    return lengthToWrite;
+    return lengthWritten;
 }
 
 size_t NanoRingBuffer_PopN(NanoRingBuffer *object, uint8_t *data, size_t length)
 {
-    size_t lengthToRead = 0;
-
-    // sanity check for 0 length
-    if (length == 0)
-    {
-        return 0;
-    }
-
-    // check for buffer empty
-    if (object->_size == 0)
-    {
-        return 0;
-    }
+    size_t lengthRead = 0;
 
-    if (length > object->_size)
+    // at most two chunks: up to the end of the storage buffer and then from its start
+    while (lengthRead < length)
     {
-        lengthToRead = object->_size;
-    }
-    else
-    {
-        lengthToRead = length;
-    }
-
-    ASSERT(lengthToRead <= object->_size);
-
-    uint8_t *source = object->_buffer;
-    source += object->_read_index;
-
-    // can read in a single memcpy
-    if (lengthToRead <= object->_capacity - object->_read_index)
-    {
-        memcpy(data, source, lengthToRead);
-        object->_read_index += lengthToRead;
+        size_t chunkSize;
+        const uint8_t *source = NanoRingBuffer_PeekRead(object, &chunkSize);
 
-        // check if we are at end of capacity
-        if (object->_read_index == object->_capacity)
+        // check for buffer empty
+        if (chunkSize == 0)
         {
-            object->_read_index = 0;
+            break;
         }
-    }
-    // need to memcpy in two steps
-    else
-    {
-        size_t chunk1Size = object->_capacity - object->_read_index;
-        memcpy(data, source, chunk1Size);
 
-        data += chunk1Size;
-        
-        size_t chunk2Size = lengthToRead - chunk1Size;
-        memcpy(data, object->_buffer, chunk2Size);
+        if (chunkSize > length - lengthRead)
+        {
+            chunkSize = length - lengthRead;
+        }
 
-        object->_read_index = chunk2Size;
-    }
+        memcpy(data + lengthRead, source, chunkSize);
 
-    // update ring buffer size
-    object->_size -= lengthToRead;
+        NanoRingBuffer_Pop(object, chunkSize);
 
-    // check for optimization to improve sequential push
-    // buffer has to be empty and read and write indexes coincide
-    if (object->_size == 0 && (object->_write_index == object->_read_index))
-    {
-        // reset the read/write index
-        object->_write_index = 0;
-        object->_read_index = 0;
+        lengthRead += chunkSize;
     }
 
-    ASSERT(object->_read_index <= object->_capacity);
-    ASSERT(object->_size <= object->_capacity);
-
-    return lengthToRead;
+    return lengthRead;
 }
 
 size_t NanoRingBuffer_Pop(NanoRingBuffer *object, size_t length)
 {
-    size_t lengthToRead = 0;
+    size_t readIndex = object->_read_index;
+    size_t usedSpace = UsedSpace(object, RINGBUFFER_LOAD_ACQUIRE(object->_write_index), readIndex);
 
-    // sanity check for 0 length
-    if (length == 0)
+    if (length > usedSpace)
     {
-        return 0;
+        length = usedSpace;
     }
 
-    // check for buffer empty
-    if (object->_size == 0)
+    if (length == 0)
     {
         return 0;
     }
 
-    if (length > object->_size)
-    {
-        lengthToRead = object->_size;
-    }
-    else
-    {
-        lengthToRead = length;
-    }
-
-    // can read in a single memcpy
-    if (lengthToRead <= object->_capacity - object->_read_index)
-    {
-        object->_read_index += lengthToRead;
-
-        // check if we are at end of capacity
-        if (object->_read_index == object->_capacity)
-        {
-            object->_read_index = 0;
-        }
-    }
-    // need to memcpy in two steps
-    else
-    {
-        size_t chunk1Size = object->_capacity - object->_read_index;
-        size_t chunk2Size = lengthToRead - chunk1Size;
-        object->_read_index = chunk2Size;
-    }
-
-    // update ring buffer size
-    object->_size -= lengthToRead;
-
-    // check for optimization to improve sequential push
-    // buffer has to be empty and read and write indexes coincide
-    if (object->_size == 0 && (object->_write_index == object->_read_index))
-    {
-        // reset the read/write index
-        object->_write_index = 0;
-        object->_read_index = 0;
-    }
-
-    ASSERT(object->_read_index <= object->_capacity);
-    ASSERT(object->_size <= object->_capacity);
+    RINGBUFFER_STORE_RELEASE(object->_read_index, WrapIndex(object, readIndex + length));
 
-    return lengthToRead;
+    return length;
 }
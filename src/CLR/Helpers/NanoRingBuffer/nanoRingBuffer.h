@@ -14,9 +14,12 @@ extern "C"
 {
 #endif
 
+// The ring buffer is safe to use without locking between a single producer (Push*, PeekWrite, CommitWrite) and a
+// single consumer (Pop*, PeekRead), which can run on an ISR, a DMA completion or another thread.
+// The read and write indexes run over [0, 2 * capacity) so a full buffer can be told apart from an empty one without
+// a shared element counter. Each index is only ever written by its owner and published with release semantics.
 typedef struct {
 
-    size_t _size;
     size_t _capacity;
     size_t _write_index;
     size_t _read_index;
@@ -49,6 +52,14 @@ size_t NanoRingBuffer_Capacity(NanoRingBuffer *object);
 ///
 size_t NanoRingBuffer_Size(NanoRingBuffer *object);
 
+/// 
+/// @brief Returns the number of bytes that can still be pushed to the ring buffer.
+/// 
+/// @param object Pointer to the NanoRingBuffer object on which the operation will be performed.
+/// @return size_t The free space in the ring buffer.
+///
+size_t NanoRingBuffer_Free(NanoRingBuffer *object);
+
 /// 
 /// @brief Pushes a single element to the buffer.
 /// 
@@ -87,8 +98,37 @@ size_t NanoRingBuffer_PopN(NanoRingBuffer *object, uint8_t *data, size_t length)
 ///
 size_t NanoRingBuffer_Pop(NanoRingBuffer *object, size_t length);
 
+/// 
+/// @brief Gets the contiguous region where the producer can write directly (e.g. from a DMA transfer).
+/// To be followed by a call to NanoRingBuffer_CommitWrite with the number of bytes actually written.
+/// 
+/// @param object Pointer to the NanoRingBuffer object on which the operation will be performed.
+/// @param length Pointer where the length of the contiguous region will be returned. Will be 0 if the buffer is full.
+/// @return uint8_t* Pointer to the start of the region.
+///
+uint8_t *NanoRingBuffer_PeekWrite(NanoRingBuffer *object, size_t *length);
+
+/// 
+/// @brief Makes available to the consumer the bytes written to the region returned by NanoRingBuffer_PeekWrite.
+/// 
+/// @param object Pointer to the NanoRingBuffer object on which the operation will be performed.
+/// @param length Number of bytes written. Can't be more than the length returned by NanoRingBuffer_PeekWrite.
+///
+void NanoRingBuffer_CommitWrite(NanoRingBuffer *object, size_t length);
+
+/// 
+/// @brief Gets the contiguous region where the consumer can read directly (e.g. to start a DMA transfer).
+/// To be followed by a call to NanoRingBuffer_Pop with the number of bytes actually consumed.
+/// 
+/// @param object Pointer to the NanoRingBuffer object on which the operation will be performed.
+/// @param length Pointer where the length of the contiguous region will be returned. Will be 0 if the buffer is empty.
+/// @return const uint8_t* Pointer to the start of the region.
+///
+const uint8_t *NanoRingBuffer_PeekRead(NanoRingBuffer *object, size_t *length);
+
 /// 
 /// @brief Optimizes the sequence of the storage buffer so all elements are contiguous.
+/// This moves both indexes, so it can't run concurrently with the producer or the consumer.
 /// 
 ///
 void OptimizeSequence(NanoRingBuffer *object);
@@ -29,6 +29,18 @@ typedef struct CLR_SETTINGS
     // This option is only available when building is set for RTM
     bool RevertToBooterOnFault;
 
+    // Length, in milliseconds, of the time slice a managed thread runs before the scheduler picks the next one.
+    // Leave at 0 to use the default (CLR_RT_Thread::c_TimeQuantum_Milliseconds).
+    unsigned short ThreadQuantumMilliseconds;
+
+    // Same as above for the threads in the real-time scheduling class.
+    // Leave at 0 to use the default (CLR_RT_Thread::c_TimeQuantum_Milliseconds_RealTime).
+    unsigned short RealTimeThreadQuantumMilliseconds;
+
+    // Set this to TRUE to run the managed threads with ThreadPriority.Highest in the real-time scheduling class.
+    // A real-time thread that becomes ready preempts any other thread at the next IL safe point.
+    bool HighestPriorityIsRealTime;
+
 #if defined(VIRTUAL_DEVICE)
     bool PerformGarbageCollection;
     bool PerformHeapCompaction;
@@ -28,6 +28,12 @@ struct CLR_HW_Hardware
         SYSTEM_EVENT_FLAG_MESSAGING_ACTIVITY | SYSTEM_EVENT_FLAG_ONEWIRE_MASTER | SYSTEM_EVENT_FLAG_RADIO |
         SYSTEM_EVENT_FLAG_WIFI_STATION | SYSTEM_EVENT_FLAG_BLUETOOTH;
 
+    // number of HAL interrupt records moved to the application queue for each acquisition of the global lock
+    static const CLR_UINT32 c_InterruptTransferBatch = 8;
+
+    // number of application interrupt records kept for reuse instead of going back to the heap
+    static const CLR_UINT32 c_MaxCachedInterrupts = 8;
+
     //--//
 
     struct HalInterruptRecord
@@ -53,6 +59,10 @@ struct CLR_HW_Hardware
         Hal_Queue_UnknownSize<HalInterruptRecord> m_HalQueue;
         CLR_RT_DblLinkedList m_applicationQueue;
         CLR_UINT32 m_queuedInterrupts;
+
+        // dispatched records waiting to be reused
+        CLR_RT_DblLinkedList m_freeInterrupts;
+        CLR_UINT32 m_freeInterruptsCount;
     };
 
     //--//
@@ -83,6 +93,10 @@ struct CLR_HW_Hardware
     HRESULT ProcessInterrupts();
     HRESULT SpawnDispatcher();
     HRESULT TransferAllInterruptsToApplicationQueue();
+
+    CLR_RT_ApplicationInterrupt *AllocateApplicationInterrupt();
+    void ReleaseApplicationInterrupt(CLR_RT_ApplicationInterrupt *interrupt);
+    void ReleaseCachedInterrupts();
 };
 
 extern CLR_HW_Hardware g_CLR_HW_Hardware;
@@ -110,6 +110,16 @@ heapdump-stop-blocks-used = int
     Reports how many heap-blocks were used by objects, including objects that might have been filtered out from
 reporting.
 
+scheduling-latency-packet = timestamp-packet scheduling-latency-header scheduling-latency-pid scheduling-latency-time
+scheduling-latency-header = "00010001"
+scheduling-latency-pid = packed-int
+scheduling-latency-time = packed-int
+packed-int = 3BIT 1*8( 4BIT )
+    Number of nibbles minus one, then the nibbles of the value, most significant first.
+    Time a thread spent in the ready queue before being dispatched, shifted right by CallTimingShift like the call
+timings. Only sent while call profiling is enabled, next to the context switch packets. Command 0x11 was added after
+the 0x01-0x10 set: a reader that doesn't know it has to stop at it, since the packet length isn't encoded.
+
  */
 
 class CLR_PRF_CMDS
@@ -137,6 +147,8 @@ class CLR_PRF_CMDS
     static const CLR_UINT32 c_Profiling_HeapCompact_Begin = 0x0f;
     static const CLR_UINT32 c_Profiling_HeapCompact_End = 0x10;
 
+    static const CLR_UINT32 c_Profiling_Calls_SchedulingLatency = 0x11;
+
     class Bits
     {
       public:
@@ -174,6 +186,7 @@ struct CLR_PRF_Profiler
 
 #if defined(NANOCLR_PROFILE_NEW_CALLS)
     HRESULT RecordContextSwitch(CLR_RT_Thread *nextThread);
+    HRESULT RecordSchedulingLatency(CLR_RT_Thread *th, CLR_INT64 latency);
     HRESULT RecordFunctionCall(CLR_RT_Thread *th, CLR_RT_MethodDef_Index md);
     HRESULT RecordFunctionReturn(CLR_RT_Thread *th, CLR_PROF_CounterCallChain &prof);
 #endif
@@ -929,7 +929,8 @@ struct CLR_RT_UnicodeHelper
         m_inputUTF16 = src;
     }
 
-    int CountNumberOfCharacters(int max = -1);
+    // maxBytes bounds the input when it isn't terminated
+    int CountNumberOfCharacters(int max = -1, int maxBytes = -1);
     int CountNumberOfBytes(int max = -1);
 
     //--//
@@ -2976,6 +2977,7 @@ struct CLR_RT_Thread : public CLR_RT_ObjectToEvent_Destination // EVENT HEAP - N
     static const CLR_UINT32 TH_F_Aborted = 0x00000002;
     static const CLR_UINT32 TH_F_System = 0x00000004;
     static const CLR_UINT32 TH_F_ContainsDoomedAppDomain = 0x00000008;
+    static const CLR_UINT32 TH_F_RealTime = 0x00000010; // runs in the real-time scheduling class
 
     static const CLR_INT32 TH_WAIT_RESULT_INIT = -1;
     static const CLR_INT32 TH_WAIT_RESULT_HANDLE_0 = 0;
@@ -2983,6 +2985,7 @@ struct CLR_RT_Thread : public CLR_RT_ObjectToEvent_Destination // EVENT HEAP - N
     static const CLR_INT32 TH_WAIT_RESULT_HANDLE_ALL = 0x103;
 
     static const CLR_UINT32 c_TimeQuantum_Milliseconds = 20;
+    static const CLR_UINT32 c_TimeQuantum_Milliseconds_RealTime = 5;
     static const int c_MaxStackUnwindDepth = 6;
 
     int m_pid;
@@ -2990,6 +2993,11 @@ struct CLR_RT_Thread : public CLR_RT_ObjectToEvent_Destination // EVENT HEAP - N
     CLR_UINT32 m_flags;
     int m_executionCounter;
     volatile bool m_timeQuantumExpired;
+    CLR_UINT32 m_readySequence; // order in which the thread entered the ready lists, breaks ties between bands
+
+#if defined(NANOCLR_PROFILE_NEW_CALLS)
+    CLR_INT64 m_readyTime; // time the thread entered the ready queue, zero while running or not ready
+#endif
 
     CLR_RT_HeapBlock_Delegate *m_dlg;    // OBJECT HEAP - DO RELOCATION -
     CLR_RT_HeapBlock m_currentException; // OBJECT HEAP - DO RELOCATION -
@@ -3645,7 +3653,20 @@ struct CLR_RT_ExecutionEngine
     CLR_RT_DblLinkedList m_timers; // EVENT HEAP - NO RELOCATION - list of CLR_RT_HeapBlock_Timer
     CLR_UINT32 m_raisedEvents;
 
-    CLR_RT_DblLinkedList m_threadsReady;   // EVENT HEAP - NO RELOCATION - list of CLR_RT_Thread
+    // Ready threads are kept in one FIFO list per priority band, m_threadsReadySequence orders entries across bands.
+    // The last band holds the real-time scheduling class, which always runs ahead of the others.
+    // m_threadsReadyBands has bit N set when band N may hold threads.
+    static const int c_ThreadReadyBand_RealTime = ThreadPriority::System_Highest + 1;
+    static const int c_ThreadReadyBands = c_ThreadReadyBand_RealTime + 1;
+
+    CLR_RT_DblLinkedList m_threadsReady[c_ThreadReadyBands]; // EVENT HEAP - NO RELOCATION - lists of CLR_RT_Thread
+    CLR_UINT32 m_threadsReadyBands;
+    CLR_UINT32 m_threadsReadySequence;
+
+    // Time quantum for each scheduling class, 0 selects the default one.
+    CLR_UINT32 m_timeQuantum_Milliseconds;
+    CLR_UINT32 m_timeQuantum_Milliseconds_RealTime;
+    bool m_fHighestPriorityIsRealTime; // Threads with ThreadPriority::Highest run in the real-time class
     CLR_RT_DblLinkedList m_threadsWaiting; // EVENT HEAP - NO RELOCATION - list of CLR_RT_Thread
     CLR_RT_DblLinkedList m_threadsZombie;  // EVENT HEAP - NO RELOCATION - list of CLR_RT_Thread
     int m_lastPid;
@@ -3663,6 +3684,43 @@ struct CLR_RT_ExecutionEngine
 
     CLR_RT_HeapBlock *m_currentUICulture; // OBJECT HEAP - DO RELOCATION -
 
+    // Identity hash codes handed out by Object.GetHashCode, kept apart from the objects so they survive the heap
+    // compaction. Entries are appended in any order and dropped by the GC when the object dies.
+    // They are found through an open addressing index on the object address, twice the size of the table and
+    // allocated in the same block, which is rebuilt whenever the objects move or entries are dropped.
+    struct IdentityHashCode
+    {
+        CLR_RT_HeapBlock *m_object; // OBJECT HEAP - DO RELOCATION -
+        CLR_UINT32 m_hashCode;
+    };
+
+    static const CLR_UINT32 c_IdentityHashCodes_InitialSize = 16;
+
+    IdentityHashCode *m_identityHashCodes;  // EVENT HEAP - NO RELOCATION -
+    CLR_UINT32 *m_identityHashCodesBuckets; // entry index + 1, zero when free, follows m_identityHashCodes
+    CLR_UINT32 m_identityHashCodesCount;
+    CLR_UINT32 m_identityHashCodesSize;
+    CLR_UINT32 m_identityHashCodeNext;
+    CLR_UINT32 m_identityHashCodesMissed; // objects that found the table full since the last reset
+
+    // Members already found by name through reflection (Type.GetField, Type.GetMethod) and the FieldInfo objects handed
+    // out, so that looking up the same member again skips the scan of the type and returns the same instance.
+    // Both tables are direct mapped, so their size is bounded. The objects are held weakly: the GC drops them when
+    // nothing else references them.
+    struct ReflectionLookup
+    {
+        CLR_UINT32 m_type; // CLR_RT_TypeDef_Index of the type searched, 0 for an empty entry
+        CLR_UINT32 m_nameHash;
+        CLR_UINT32 m_flags;  // binding flags, plus c_ReflectionLookup_Field for a field
+        CLR_UINT32 m_member; // CLR_RT_FieldDef_Index or CLR_RT_MethodDef_Index found
+    };
+
+    static const CLR_UINT32 c_ReflectionCache_Size = 32; // must be a power of 2
+    static const CLR_UINT32 c_ReflectionLookup_Field = 0x80000000;
+
+    ReflectionLookup m_reflectionLookups[c_ReflectionCache_Size];
+    CLR_RT_HeapBlock *m_reflectionObjects[c_ReflectionCache_Size]; // OBJECT HEAP - DO RELOCATION -
+
     //--//
 
     CLR_RT_Thread *m_interruptThread; // EVENT HEAP - NO RELOCATION
@@ -3706,6 +3764,16 @@ struct CLR_RT_ExecutionEngine
 
     void Relocate();
 
+    CLR_UINT32 GetIdentityHashCode(CLR_RT_HeapBlock *obj);
+    HRESULT IdentityHashCodes_Reserve(CLR_UINT32 count);
+    void IdentityHashCodes_Purge();
+    void IdentityHashCodes_Rehash();
+
+    bool ReflectionLookup_Find(const CLR_RT_TypeDef_Index &type, const char *name, CLR_UINT32 flags, CLR_UINT32 &member);
+    void ReflectionLookup_Add(const CLR_RT_TypeDef_Index &type, const char *name, CLR_UINT32 flags, CLR_UINT32 member);
+    HRESULT GetReflectionObject(CLR_RT_HeapBlock &ref, const CLR_RT_TypeDef_Index &cls, const CLR_RT_FieldDef_Index &fd);
+    void ReflectionCache_Purge();
+
     HRESULT ScheduleThreads(int maxContextSwitch);
 
     CLR_UINT32 WaitForActivity(CLR_UINT32 powerLevel, CLR_UINT32 events, CLR_INT64 timeout_ms);
@@ -3745,6 +3813,15 @@ struct CLR_RT_ExecutionEngine
     void PutInProperList(CLR_RT_Thread *th);
     CLR_INT32 GetNextThreadId();
 
+    CLR_RT_Thread *FirstReadyThread();
+    bool HasReadyThreads();
+    int NumOfReadyThreads();
+
+    void ConfigureScheduler(const CLR_SETTINGS &params);
+    bool IsRealTimeThread(CLR_RT_Thread *th) const;
+    void UpdateSchedulingClass(CLR_RT_Thread *th);
+    CLR_UINT32 GetTimeQuantum(CLR_RT_Thread *th) const;
+
     HRESULT InitializeReference(CLR_RT_HeapBlock &ref, CLR_RT_SignatureParser &parser);
     HRESULT InitializeReference(CLR_RT_HeapBlock &ref, const CLR_RECORD_FIELDDEF *target, CLR_RT_Assembly *assm);
 
@@ -3871,7 +3948,7 @@ struct CLR_RT_ExecutionEngine
     void ReleaseAllThreads(CLR_RT_DblLinkedList &threads);
     void AbortAllThreads(CLR_RT_DblLinkedList &threads);
 
-    void InsertThreadRoundRobin(CLR_RT_DblLinkedList &threads, CLR_RT_Thread *th);
+    void InsertThreadRoundRobin(CLR_RT_Thread *th);
 
     CLR_UINT32 WaitSystemEvents(CLR_UINT32 powerLevel, CLR_UINT32 events, CLR_INT64 timeExpire);
 
@@ -1779,6 +1779,16 @@ struct CLR_RT_AVLTree
 
 struct CLR_RT_HeapBlock_String : public CLR_RT_HeapBlock
 {
+    // Strings allocated on the heap have two CLR_UINT32 right before the UTF-8 text: the first caches the number of
+    // UTF-16 characters and whether the text is all ASCII, the second the hash code of the text (0 until computed).
+    // Both are computed on first use, because the text is filled in by the caller after the allocation. Strings
+    // pointing to the assembly string table don't have them.
+    static const CLR_UINT32 c_CachedInfoSize = 2 * sizeof(CLR_UINT32);
+    static const CLR_UINT32 c_TextInfo_Computed = 0x80000000;
+    static const CLR_UINT32 c_TextInfo_Ascii = 0x40000000;
+    static const CLR_UINT32 c_TextInfo_Invalid = 0x20000000;
+    static const CLR_UINT32 c_TextInfo_LengthMask = 0x1FFFFFFF;
+
     static CLR_RT_HeapBlock_String *CreateInstance(CLR_RT_HeapBlock &reference, CLR_UINT32 length);
     static HRESULT CreateInstance(CLR_RT_HeapBlock &reference, const char *szText);
     static HRESULT CreateInstance(CLR_RT_HeapBlock &reference, const char *szText, CLR_UINT32 length);
@@ -1787,6 +1797,27 @@ struct CLR_RT_HeapBlock_String : public CLR_RT_HeapBlock
     static HRESULT CreateInstance(CLR_RT_HeapBlock &reference, CLR_UINT16 *szText, CLR_UINT32 length);
 
     static CLR_RT_HeapBlock_String *GetStringEmpty();
+
+    // creates a string with the concatenation of the strings in parts (entries that aren't strings are skipped)
+    static HRESULT CreateConcatenation(CLR_RT_HeapBlock &reference, CLR_RT_HeapBlock *parts, CLR_UINT32 count);
+
+    // number of UTF-16 characters in the string, -1 if the text isn't valid UTF-8
+    int GetLength();
+    // number of bytes of the UTF-8 text
+    CLR_UINT32 GetLengthInBytes();
+    bool IsAscii();
+
+    static CLR_UINT32 ComputeTextInfo(const char *szText);
+    // for heap strings just filled with ASCII text, so it doesn't have to be scanned again
+    void SetAsciiTextInfo(CLR_UINT32 length);
+
+    // hash code of the UTF-8 text, equal strings have the same hash code regardless of where the text is stored
+    CLR_UINT32 GetTextHashCode();
+    static CLR_UINT32 ComputeHashCode(const char *szText, CLR_UINT32 length);
+
+  private:
+    CLR_UINT32 *GetCachedInfo();
+    CLR_UINT32 GetTextInfo();
 };
 
 struct CLR_RT_HeapBlock_Array : public CLR_RT_HeapBlock
@@ -2762,12 +2793,7 @@ struct CLR_RT_HeapBlock_Queue : public CLR_RT_HeapBlock
     // Keep in-sync with _defaultCapacity in System.Collections.Queue class in Queue.cs
     static const CLR_INT32 c_DefaultCapacity = 4;
 
-    static HRESULT ObjArrayMemcpy(
-        CLR_RT_HeapBlock_Array *arraySrc,
-        int indexSrc,
-        CLR_RT_HeapBlock_Array *arrayDst,
-        int indexDst,
-        int length);
+    HRESULT Grow();
 
     __inline CLR_RT_HeapBlock_Array *GetArray()
     {
@@ -173,6 +173,25 @@ struct CLR_RT_BinaryFormatter : public CLR_RT_HeapBlock_Node // EVENT HEAP - NO
          HRESULT TrackObject        ( int& res                                                        );
     };
 
+    //
+    // Serialization plan of a class: the fields to walk, in stream order (derived class first), with the
+    // hints and type descriptors already resolved, so that they are computed once per type and not once per object.
+    //
+    struct FieldPlan
+    {
+        CLR_UINT32                  m_offset;           // offset of the field in the object
+        SerializationHintsAttribute m_hints;
+        CLR_RT_TypeDescriptor       m_desc;
+    };
+
+    struct TypePlan // EVENT HEAP - NO RELOCATION -
+    {
+        TypePlan*            m_next;
+        CLR_RT_TypeDef_Index m_cls;
+        int                  m_numFields;
+        FieldPlan            m_fields[1];               // actually m_numFields entries
+    };
+
     struct State : public CLR_RT_HeapBlock_Node // EVENT HEAP - NO RELOCATION -
     {
         CLR_RT_BinaryFormatter*      m_parent;
@@ -184,6 +203,7 @@ struct CLR_RT_BinaryFormatter : public CLR_RT_HeapBlock_Node // EVENT HEAP - NO
         CLR_RT_TypeDef_Instance      m_fields_CurrentClass;
         int                          m_fields_CurrentField;
         CLR_RT_HeapBlock*            m_fields_Pointer;
+        TypePlan*                    m_fields_Plan;          // when set, m_fields_CurrentField indexes the plan
 
         bool                         m_array_NeedProcessing;
         CLR_RT_TypeDescriptor*       m_array_ExpectedType;
@@ -199,8 +219,8 @@ struct CLR_RT_BinaryFormatter : public CLR_RT_HeapBlock_Node // EVENT HEAP - NO
 
          void DestroyInstance();
 
-         HRESULT FindHints( SerializationHintsAttribute& hints, const CLR_RT_TypeDef_Instance&  cls );
-         HRESULT FindHints( SerializationHintsAttribute& hints, const CLR_RT_FieldDef_Instance& fld );
+         static HRESULT FindHints( SerializationHintsAttribute& hints, const CLR_RT_TypeDef_Instance&  cls );
+         static HRESULT FindHints( SerializationHintsAttribute& hints, const CLR_RT_FieldDef_Instance& fld );
 
         //--//
 
@@ -217,18 +237,17 @@ struct CLR_RT_BinaryFormatter : public CLR_RT_HeapBlock_Node // EVENT HEAP - NO
     };
 
 
-    struct DuplicateTracker : public CLR_RT_HeapBlock_Node // EVENT HEAP - NO RELOCATION -
-    {
-        CLR_RT_HeapBlock* m_ptr;
-        CLR_UINT32        m_idx;
-    };
+    static const CLR_UINT32 c_Duplicates_InitialSize = 16;
 
     //--//
 
     CLR_RT_HeapBlock_MemoryStream* m_stream;
-    CLR_UINT32                     m_idx;
+    CLR_UINT32                     m_idx;                   // number of objects in m_duplicates, also the next duplicate id
     CLR_UINT32                     m_lastTypeRead;
-    CLR_RT_DblLinkedList           m_duplicates;            // EVENT HEAP - NO RELOCATION - list of CLR_RT_BinaryFormatter::DuplicateTracker
+    CLR_RT_HeapBlock**             m_duplicates;            // EVENT HEAP - NO RELOCATION - tracked objects, indexed by duplicate id
+    CLR_UINT32*                    m_duplicatesHash;        // EVENT HEAP - NO RELOCATION - open addressing table of (duplicate id + 1), keyed by address. Serialization only.
+    CLR_UINT32                     m_duplicatesSize;        // capacity of m_duplicates, the hash table has twice as many buckets
+    TypePlan*                      m_plans;                 // EVENT HEAP - NO RELOCATION - list of the plans built so far
     CLR_RT_DblLinkedList           m_states;                // EVENT HEAP - NO RELOCATION - list of CLR_RT_BinaryFormatter::State
     
     bool                           m_fDeserialize;
@@ -253,6 +272,9 @@ struct CLR_RT_BinaryFormatter : public CLR_RT_HeapBlock_Node // EVENT HEAP - NO
      HRESULT           TrackDuplicate ( CLR_RT_HeapBlock* object );
      CLR_UINT32        SearchDuplicate( CLR_RT_HeapBlock* object );
      CLR_RT_HeapBlock* GetDuplicate   ( CLR_UINT32        idx    );
+     HRESULT           GrowDuplicates (                          );
+
+     HRESULT GetTypePlan( const CLR_RT_TypeDef_Index& cls, TypePlan*& plan );
 
     //--//
 
@@ -45,6 +45,8 @@ struct Settings
         CLR_Debug::Printf("Created EE.\r\n");
 #endif
 
+        g_CLR_RT_ExecutionEngine.ConfigureScheduler(params);
+
 #if !defined(BUILD_RTM)
         if (params.WaitForDebugger)
         {
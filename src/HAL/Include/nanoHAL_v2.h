@@ -281,6 +281,12 @@ extern "C"
 
 #define HAL_COMPLETION_IDLE_VALUE 0x0000FFFFFFFFFFFFull
 
+// maximum number of HAL_COMPLETION that can be queued at the same time
+// can be overriden at target level in target_common.h
+#ifndef HAL_COMPLETION_QUEUE_SIZE
+#define HAL_COMPLETION_QUEUE_SIZE 16
+#endif
+
 // provide platform dependent delay to CLR code
 #if defined(VIRTUAL_DEVICE)
 #define OS_DELAY(milliSecs) ;
@@ -10,6 +10,206 @@
 
 HAL_DblLinkedList<HAL_CONTINUATION> g_HAL_Completion_List;
 
+// Completions are kept in a binary min-heap ordered by EventTimeTicks, so enqueuing and dequeuing is O(log n) instead
+// of walking the list while holding the global lock. g_HAL_Completion_List still holds every queued completion so
+// HAL_CONTINUATION::IsLinked() and Uninitialize() keep working as before.
+// When the heap is full, further completions wait in a list sorted by EventTimeTicks (the original scheme) and move
+// into the heap as soon as it has room, so a burst above HAL_COMPLETION_QUEUE_SIZE is slower but never loses an event.
+static HAL_COMPLETION *s_HAL_Completion_Queue[HAL_COMPLETION_QUEUE_SIZE];
+static uint32_t s_HAL_Completion_QueueCount;
+static HAL_DblLinkedList<HAL_CONTINUATION> s_HAL_Completion_Overflow;
+
+#if !defined(BUILD_RTM)
+uint64_t HAL_COMPLETION::MaxLockHeldTicks;
+
+#define COMPLETION_LOCK_START() uint64_t lockStartTicks = HAL_Time_CurrentSysTicks()
+#define COMPLETION_LOCK_END()                                                                                          \
+    {                                                                                                                  \
+        uint64_t lockHeldTicks = HAL_Time_CurrentSysTicks() - lockStartTicks;                                          \
+        if (lockHeldTicks > HAL_COMPLETION::MaxLockHeldTicks)                                                          \
+        {                                                                                                              \
+            HAL_COMPLETION::MaxLockHeldTicks = lockHeldTicks;                                                          \
+        }                                                                                                              \
+    }
+#else
+#define COMPLETION_LOCK_START()
+#define COMPLETION_LOCK_END()
+#endif
+
+/***************************************************************************/
+
+static void CompletionQueue_Place(HAL_COMPLETION *ptr, uint32_t index)
+{
+    s_HAL_Completion_Queue[index] = ptr;
+    ptr->QueueIndex = index;
+}
+
+static void CompletionQueue_SiftUp(uint32_t index)
+{
+    HAL_COMPLETION *ptr = s_HAL_Completion_Queue[index];
+
+    while (index > 0)
+    {
+        uint32_t parent = (index - 1) / 2;
+
+        // strict comparison keeps the order of completions with the same expire time close to FIFO
+        if (s_HAL_Completion_Queue[parent]->EventTimeTicks <= ptr->EventTimeTicks)
+        {
+            break;
+        }
+
+        CompletionQueue_Place(s_HAL_Completion_Queue[parent], index);
+        index = parent;
+    }
+
+    CompletionQueue_Place(ptr, index);
+}
+
+static void CompletionQueue_SiftDown(uint32_t index)
+{
+    HAL_COMPLETION *ptr = s_HAL_Completion_Queue[index];
+
+    while (true)
+    {
+        uint32_t child = 2 * index + 1;
+
+        if (child >= s_HAL_Completion_QueueCount)
+        {
+            break;
+        }
+
+        if (child + 1 < s_HAL_Completion_QueueCount &&
+            s_HAL_Completion_Queue[child + 1]->EventTimeTicks < s_HAL_Completion_Queue[child]->EventTimeTicks)
+        {
+            child++;
+        }
+
+        if (ptr->EventTimeTicks <= s_HAL_Completion_Queue[child]->EventTimeTicks)
+        {
+            break;
+        }
+
+        CompletionQueue_Place(s_HAL_Completion_Queue[child], index);
+        index = child;
+    }
+
+    CompletionQueue_Place(ptr, index);
+}
+
+static bool CompletionQueue_Contains(HAL_COMPLETION *ptr)
+{
+    return ptr->QueueIndex < s_HAL_Completion_QueueCount && s_HAL_Completion_Queue[ptr->QueueIndex] == ptr;
+}
+
+static HAL_COMPLETION *CompletionOverflow_First()
+{
+    return (HAL_COMPLETION *)s_HAL_Completion_Overflow.FirstValidNode();
+}
+
+static void CompletionOverflow_Insert(HAL_COMPLETION *ptr)
+{
+    HAL_COMPLETION *node = (HAL_COMPLETION *)s_HAL_Completion_Overflow.FirstNode();
+    HAL_COMPLETION *nodeNext;
+
+    // find position based on time, entries with the same expire time stay in FIFO order
+    while ((nodeNext = (HAL_COMPLETION *)node->Next()) != NULL)
+    {
+        if (ptr->EventTimeTicks < node->EventTimeTicks)
+        {
+            break;
+        }
+
+        node = nodeNext;
+    }
+
+    s_HAL_Completion_Overflow.InsertBeforeNode(node, ptr);
+}
+
+static HAL_COMPLETION *CompletionQueue_Top()
+{
+    HAL_COMPLETION *top = s_HAL_Completion_QueueCount ? s_HAL_Completion_Queue[0] : NULL;
+    HAL_COMPLETION *overflow = CompletionOverflow_First();
+
+    if (overflow && (top == NULL || overflow->EventTimeTicks < top->EventTimeTicks))
+    {
+        return overflow;
+    }
+
+    return top;
+}
+
+static void CompletionQueue_Push(HAL_COMPLETION *ptr)
+{
+    s_HAL_Completion_Queue[s_HAL_Completion_QueueCount] = ptr;
+    CompletionQueue_SiftUp(s_HAL_Completion_QueueCount++);
+
+    g_HAL_Completion_List.LinkAtBack(ptr);
+}
+
+static void CompletionQueue_Insert(HAL_COMPLETION *ptr)
+{
+    if (s_HAL_Completion_QueueCount < HAL_COMPLETION_QUEUE_SIZE)
+    {
+        CompletionQueue_Push(ptr);
+    }
+    else
+    {
+        CompletionOverflow_Insert(ptr);
+    }
+}
+
+// unlinks the completion from wherever it is queued, it's fine to call it for a completion that isn't queued
+static void CompletionQueue_Remove(HAL_COMPLETION *ptr)
+{
+    if (CompletionQueue_Contains(ptr))
+    {
+        uint32_t index = ptr->QueueIndex;
+        HAL_COMPLETION *last = s_HAL_Completion_Queue[--s_HAL_Completion_QueueCount];
+
+        s_HAL_Completion_Queue[s_HAL_Completion_QueueCount] = NULL;
+
+        if (last != ptr)
+        {
+            s_HAL_Completion_Queue[index] = last;
+
+            if (index > 0 && last->EventTimeTicks < s_HAL_Completion_Queue[(index - 1) / 2]->EventTimeTicks)
+            {
+                CompletionQueue_SiftUp(index);
+            }
+            else
+            {
+                CompletionQueue_SiftDown(index);
+            }
+        }
+
+        ptr->Unlink();
+
+        // there is room again, move the earliest waiting completion into the heap
+        HAL_COMPLETION *overflow = CompletionOverflow_First();
+
+        if (overflow)
+        {
+            overflow->Unlink();
+
+            CompletionQueue_Push(overflow);
+        }
+    }
+    else
+    {
+        ptr->Unlink();
+    }
+}
+
+static void CompletionQueue_Clear()
+{
+    while (s_HAL_Completion_QueueCount)
+    {
+        s_HAL_Completion_Queue[--s_HAL_Completion_QueueCount] = NULL;
+    }
+
+    s_HAL_Completion_Overflow.Initialize();
+}
+
 /***************************************************************************/
 
 void HAL_COMPLETION::Execute()
@@ -38,6 +238,7 @@ void HAL_COMPLETION::InitializeList()
 {
     NATIVE_PROFILE_PAL_ASYNC_PROC_CALL();
     g_HAL_Completion_List.Initialize();
+    CompletionQueue_Clear();
 }
 
 //--//
@@ -47,19 +248,20 @@ void HAL_COMPLETION::DequeueAndExec()
     NATIVE_PROFILE_PAL_ASYNC_PROC_CALL();
 
     GLOBAL_LOCK();
+    COMPLETION_LOCK_START();
 
-    HAL_COMPLETION *ptr = (HAL_COMPLETION *)g_HAL_Completion_List.FirstNode();
+    HAL_COMPLETION *ptr = CompletionQueue_Top();
 
     // waitforevents does not have an associated completion, therefore we need to verify
     // than their is a next completion and that the current one has expired.
-    if (ptr->Next())
+    if (ptr)
     {
         // Current one expired ?
         if (HAL_Time_CurrentTime() >= ptr->EventTimeTicks)
         {
             Events_Set(SYSTEM_EVENT_FLAG_SYSTEM_TIMER);
 
-            ptr->Unlink();
+            CompletionQueue_Remove(ptr);
 
 #if defined(_DEBUG)
             ptr->EventTimeTicks = 0;
@@ -67,13 +269,16 @@ void HAL_COMPLETION::DequeueAndExec()
 
             //// let the ISR turn on interrupts, if it needs to
             ptr->Execute();
+
+            ptr = CompletionQueue_Top();
         }
 
         //
         // Set the next timer to run otherwise set the next interrupt to be 356 years since last powerup (@25kHz).
-        Time_SetCompare(ptr->Next() ? ptr->EventTimeTicks : HAL_COMPLETION_IDLE_VALUE);
+        Time_SetCompare(ptr ? ptr->EventTimeTicks : HAL_COMPLETION_IDLE_VALUE);
     }
 
+    COMPLETION_LOCK_END();
     GLOBAL_UNLOCK();
 }
 
@@ -84,41 +289,30 @@ void HAL_COMPLETION::EnqueueTicks(uint64_t eventTimeTicks)
     NATIVE_PROFILE_PAL_ASYNC_PROC_CALL();
     ASSERT(eventTimeTicks != 0);
 
+    GLOBAL_LOCK();
+    COMPLETION_LOCK_START();
+
+    HAL_COMPLETION *firstNode = CompletionQueue_Top();
+
+    // re-scheduling a completion that is already queued moves it to the new expire time
+    CompletionQueue_Remove(this);
+
     this->EventTimeTicks = eventTimeTicks;
 
 #if defined(_DEBUG)
     this->Start_RTC_Ticks = HAL_Time_CurrentSysTicks();
 #endif
 
-    GLOBAL_LOCK();
+    CompletionQueue_Insert(this);
 
-    HAL_COMPLETION *ptr = (HAL_COMPLETION *)g_HAL_Completion_List.FirstNode();
-    HAL_COMPLETION *ptrNext;
+    HAL_COMPLETION *nextNode = CompletionQueue_Top();
 
-    // If not empty list the find position in Completion list based on time
-    // If empty just add at head.
-    if (!g_HAL_Completion_List.IsEmpty())
+    if (nextNode != firstNode || nextNode == this)
     {
-        do
-        {
-            ptrNext = (HAL_COMPLETION *)ptr->Next();
-
-            if (eventTimeTicks < ptr->EventTimeTicks)
-            {
-                break;
-            }
-
-            ptr = ptrNext;
-        } while (ptr);
-    }
-
-    g_HAL_Completion_List.InsertBeforeNode(ptr, this);
-
-    if (this == g_HAL_Completion_List.FirstNode())
-    {
-        Time_SetCompare(eventTimeTicks);
+        Time_SetCompare(nextNode ? nextNode->EventTimeTicks : HAL_COMPLETION_IDLE_VALUE);
     }
 
+    COMPLETION_LOCK_END();
     GLOBAL_UNLOCK();
 }
 
@@ -147,10 +341,11 @@ void HAL_COMPLETION::Abort()
     NATIVE_PROFILE_PAL_ASYNC_PROC_CALL();
 
     GLOBAL_LOCK();
+    COMPLETION_LOCK_START();
 
-    HAL_COMPLETION *firstNode = (HAL_COMPLETION *)g_HAL_Completion_List.FirstNode();
+    HAL_COMPLETION *firstNode = CompletionQueue_Top();
 
-    this->Unlink();
+    CompletionQueue_Remove(this);
 
 #if defined(_DEBUG)
     this->Start_RTC_Ticks = 0;
@@ -158,26 +353,16 @@ void HAL_COMPLETION::Abort()
 
     if (firstNode == this)
     {
-        uint64_t nextTicks;
-
-        if (g_HAL_Completion_List.IsEmpty())
-        {
-            //
-            // In case there's no other request to serve, set the next interrupt to be 356 years since last powerup
-            // (@25kHz).
-            //
-            nextTicks = HAL_COMPLETION_IDLE_VALUE;
-        }
-        else
-        {
-            firstNode = (HAL_COMPLETION *)g_HAL_Completion_List.FirstNode();
-
-            nextTicks = firstNode->EventTimeTicks;
-        }
+        //
+        // In case there's no other request to serve, set the next interrupt to be 356 years since last powerup
+        // (@25kHz).
+        //
+        firstNode = CompletionQueue_Top();
 
-        Time_SetCompare(nextTicks);
+        Time_SetCompare(firstNode ? firstNode->EventTimeTicks : HAL_COMPLETION_IDLE_VALUE);
     }
 
+    COMPLETION_LOCK_END();
     GLOBAL_UNLOCK();
 }
 
@@ -196,11 +381,11 @@ void HAL_COMPLETION::WaitForInterrupts(uint64_t expireTimeInTicks, uint32_t slee
     const int resetCompare = 2;
     const int nilCompare = 4;
 
-    HAL_COMPLETION *ptr = (HAL_COMPLETION *)g_HAL_Completion_List.FirstNode();
+    HAL_COMPLETION *ptr = CompletionQueue_Top();
     int state;
 
     // Any Completion events been Queued ?
-    if (ptr->Next() == NULL)
+    if (ptr == NULL)
     {
         // No
         state = setCompare | nilCompare;
@@ -229,8 +414,8 @@ void HAL_COMPLETION::WaitForInterrupts(uint64_t expireTimeInTicks, uint32_t slee
     {
         // let's get the first node again
         // it could have changed since CPU_Sleep re-enabled interrupts
-        ptr = (HAL_COMPLETION *)g_HAL_Completion_List.FirstNode();
-        Time_SetCompare((state & resetCompare) ? ptr->EventTimeTicks : HAL_COMPLETION_IDLE_VALUE);
+        ptr = CompletionQueue_Top();
+        Time_SetCompare(ptr ? ptr->EventTimeTicks : HAL_COMPLETION_IDLE_VALUE);
     }
 }
 
@@ -246,11 +431,18 @@ void HAL_COMPLETION::Uninitialize()
     {
         ptr = (HAL_COMPLETION *)g_HAL_Completion_List.ExtractFirstNode();
 
+        if (!ptr)
+        {
+            ptr = (HAL_COMPLETION *)s_HAL_Completion_Overflow.ExtractFirstNode();
+        }
+
         if (!ptr)
         {
             break;
         }
     }
 
+    CompletionQueue_Clear();
+
     GLOBAL_UNLOCK();
 }
@@ -100,6 +100,9 @@ struct HAL_COMPLETION : public HAL_CONTINUATION
     uint64_t EventTimeTicks;
     bool ExecuteInISR;
 
+    // position in the completion queue heap, only meaningful while queued
+    uint32_t QueueIndex;
+
 #if defined(_DEBUG)
     uint64_t Start_RTC_Ticks;
 #endif
@@ -135,6 +138,11 @@ struct HAL_COMPLETION : public HAL_CONTINUATION
     static void DequeueAndExec();
 
     static void WaitForInterrupts(uint64_t expireTimeInSysTicks, uint32_t sleepLevel, uint64_t wakeEvents);
+
+#if !defined(BUILD_RTM)
+    // longest time (in sys ticks) the completion queue kept the global lock
+    static uint64_t MaxLockHeldTicks;
+#endif
 };
 
 //--//
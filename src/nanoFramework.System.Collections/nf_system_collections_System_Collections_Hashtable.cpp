@@ -16,14 +16,136 @@ const size_t lenghtOfPrimes = ARRAYSIZE(s_primes);
 
 typedef Library_nf_system_collections_System_Collections_Bucket BucketType;
 
+// Key comparison for the probe loop. Strings and boxed integers, by far the most common keys, are compared directly,
+// anything else goes through ObjectsEqual.
+static bool KeysEqual(CLR_RT_HeapBlock *left, CLR_RT_HeapBlock *right)
+{
+    CLR_DataType dataType;
+
+    if (left == right)
+    {
+        return true;
+    }
+
+    dataType = left->DataType();
+
+    if (dataType == DATATYPE_STRING && right->DataType() == DATATYPE_STRING)
+    {
+        CLR_RT_HeapBlock_String *leftStr = (CLR_RT_HeapBlock_String *)left;
+        CLR_RT_HeapBlock_String *rightStr = (CLR_RT_HeapBlock_String *)right;
+        CLR_UINT32 length = leftStr->GetLengthInBytes();
+
+        return length == rightStr->GetLengthInBytes() &&
+               memcmp(leftStr->StringText(), rightStr->StringText(), length) == 0;
+    }
+
+    if (dataType == DATATYPE_VALUETYPE && right->DataType() == DATATYPE_VALUETYPE && left->DataSize() == 2 &&
+        left->ObjectCls().m_data == right->ObjectCls().m_data)
+    {
+        const CLR_RT_HeapBlock &leftValue = left[CLR_RT_HeapBlock::HB_Object_Fields_Offset];
+        const CLR_RT_HeapBlock &rightValue = right[CLR_RT_HeapBlock::HB_Object_Fields_Offset];
+
+        if (leftValue.DataType() == rightValue.DataType())
+        {
+            switch (leftValue.DataType())
+            {
+                case DATATYPE_BOOLEAN:
+                case DATATYPE_I1:
+                case DATATYPE_U1:
+                    return leftValue.NumericByRefConst().u1 == rightValue.NumericByRefConst().u1;
+
+                case DATATYPE_CHAR:
+                case DATATYPE_I2:
+                case DATATYPE_U2:
+                    return leftValue.NumericByRefConst().u2 == rightValue.NumericByRefConst().u2;
+
+                case DATATYPE_I4:
+                case DATATYPE_U4:
+                    return leftValue.NumericByRefConst().u4 == rightValue.NumericByRefConst().u4;
+
+                case DATATYPE_I8:
+                case DATATYPE_U8:
+                    return (CLR_UINT64)leftValue.NumericByRefConst().u8 == (CLR_UINT64)rightValue.NumericByRefConst().u8;
+
+                default:
+                    // floating point (NaN) and the other value types follow the general rules
+                    break;
+            }
+        }
+    }
+
+    return CLR_RT_HeapBlock::ObjectsEqual(*left, *right, true);
+}
+
+// Probes the buckets for key, following the double hashing sequence. Returns the bucket holding the key or NULL.
+// Buckets are never removed from the array, only emptied, so a slot that never held one ends the sequence: no key can
+// be stored past it. When freeSlot isn't NULL it receives the first slot where the key can be stored (-1 if none).
+static CLR_RT_HeapBlock *FindBucket(
+    CLR_RT_HeapBlock_Array *buckets,
+    CLR_RT_HeapBlock *key,
+    int32_t keyHashCode,
+    int32_t *freeSlot)
+{
+    CLR_RT_HeapBlock *elements = (CLR_RT_HeapBlock *)buckets->GetFirstElement();
+    uint32_t bucketsLength = buckets->m_numOfElements;
+    int32_t firstFree = -1;
+    uint32_t hashcode;
+    uint32_t seed;
+    uint32_t incr;
+    uint32_t bucketNumber;
+
+    hashcode = Library_nf_system_collections_System_Collections_Hashtable::InitHash(
+        keyHashCode,
+        (int32_t)bucketsLength,
+        &seed,
+        &incr);
+
+    bucketNumber = seed % bucketsLength;
+
+    for (uint32_t entry = 0; entry < bucketsLength; entry++)
+    {
+        CLR_RT_HeapBlock *bucket = elements[bucketNumber].Dereference();
+        CLR_RT_HeapBlock *bucketKey;
+
+        if (bucket == NULL)
+        {
+            if (firstFree < 0)
+            {
+                firstFree = (int32_t)bucketNumber;
+            }
+
+            break;
+        }
+
+        bucketKey = bucket[BucketType::FIELD___key].Dereference();
+
+        if (bucketKey == NULL)
+        {
+            if (firstFree < 0)
+            {
+                firstFree = (int32_t)bucketNumber;
+            }
+        }
+        else if (bucket[BucketType::FIELD___hash].NumericByRef().u4 == hashcode && KeysEqual(bucketKey, key))
+        {
+            return bucket;
+        }
+
+        bucketNumber = (bucketNumber + incr) % bucketsLength;
+    }
+
+    if (freeSlot != NULL)
+    {
+        *freeSlot = firstFree;
+    }
+
+    return NULL;
+}
+
 HRESULT Library_nf_system_collections_System_Collections_Hashtable::Clear___VOID(CLR_RT_StackFrame &stack)
 {
     NANOCLR_HEADER();
 
-    int32_t bucketNumber;
-    int32_t bucketsLength;
-    CLR_RT_HeapBlock *bucket;
-    CLR_RT_HeapBlock *bucketElement;
     CLR_RT_HeapBlock_Array *buckets;
 
     CLR_RT_HeapBlock *pThis;
@@ -37,21 +159,9 @@ HRESULT Library_nf_system_collections_System_Collections_Hashtable::Clear___VOID
     }
 
     buckets = pThis[FIELD___buckets].DereferenceArray();
-    bucketsLength = buckets->m_numOfElements;
 
-    for (bucketNumber = 0; bucketNumber < bucketsLength; bucketNumber++)
-    {
-        bucketElement = ((CLR_RT_HeapBlock *)buckets->GetElement(bucketNumber));
-        bucket = bucketElement->Dereference();
-
-        // sanity check: can only clear buckets that already have objects
-        if (bucket != NULL)
-        {
-            bucket[BucketType::FIELD___hash].NumericByRef().u4 = 0;
-            bucket[BucketType::FIELD___value].SetObjectReference(NULL);
-            bucket[BucketType::FIELD___key].SetObjectReference(NULL);
-        }
-    }
+    // drop the buckets altogether: empty ones would still have to be walked by every probe
+    NANOCLR_CHECK_HRESULT(buckets->ClearElements(0, buckets->m_numOfElements));
 
     // reset count field
     pThis[FIELD___count].NumericByRef().s4 = 0;
@@ -67,16 +177,7 @@ HRESULT Library_nf_system_collections_System_Collections_Hashtable::ContainsNati
 {
     NANOCLR_HEADER();
 
-    int32_t entry = 0;
-    int32_t bucketNumber;
-    uint32_t hashcode;
-    int32_t keyHashCode;
-    uint32_t seed;
-    uint32_t incr;
-    int32_t bucketsLength;
     CLR_RT_HeapBlock *key;
-    CLR_RT_HeapBlock *bucket;
-    CLR_RT_HeapBlock *bucketElement;
     CLR_RT_HeapBlock_Array *buckets;
 
     CLR_RT_HeapBlock *pThis;
@@ -87,36 +188,9 @@ HRESULT Library_nf_system_collections_System_Collections_Hashtable::ContainsNati
     key = stack.Arg1().Dereference();
     FAULT_ON_NULL_ARG(key);
 
-    keyHashCode = stack.Arg2().NumericByRef().s4;
-
     buckets = pThis[FIELD___buckets].DereferenceArray();
-    bucketsLength = buckets->m_numOfElements;
-
-    hashcode = InitHash(keyHashCode, bucketsLength, &seed, &incr);
-
-    bucketNumber = (int)(seed % (uint32_t)bucketsLength);
-
-    do
-    {
-        bucketElement = ((CLR_RT_HeapBlock *)buckets->GetElement(bucketNumber));
-        bucket = bucketElement->Dereference();
-
-        if (bucket != NULL && bucket[BucketType::FIELD___key].Dereference() != NULL &&
-            (bucket[BucketType::FIELD___hash].NumericByRef().u4 == hashcode) &&
-            (CLR_RT_HeapBlock::ObjectsEqual(*bucket[BucketType::FIELD___key].Dereference(), *key, true)))
-        {
-            // found
-            stack.SetResult_Boolean(true);
-
-            NANOCLR_SET_AND_LEAVE(S_OK)
-        }
-
-        bucketNumber = (int32_t)((bucketNumber + incr) % (uint32_t)bucketsLength);
-
-    } while (++entry < bucketsLength);
 
-    // not found
-    stack.SetResult_Boolean(false);
+    stack.SetResult_Boolean(FindBucket(buckets, key, stack.Arg2().NumericByRef().s4, NULL) != NULL);
 
     NANOCLR_NOCLEANUP();
 }
@@ -126,16 +200,8 @@ HRESULT Library_nf_system_collections_System_Collections_Hashtable::RemoveNative
 {
     NANOCLR_HEADER();
 
-    int32_t entry = 0;
-    int32_t bucketNumber;
-    uint32_t hashcode;
-    int32_t keyHashCode;
-    uint32_t seed;
-    uint32_t incr;
-    int32_t bucketsLength;
     CLR_RT_HeapBlock *key;
     CLR_RT_HeapBlock *bucket;
-    CLR_RT_HeapBlock *bucketElement;
     CLR_RT_HeapBlock_Array *buckets;
 
     CLR_RT_HeapBlock *pThis;
@@ -146,42 +212,25 @@ HRESULT Library_nf_system_collections_System_Collections_Hashtable::RemoveNative
     key = stack.Arg1().Dereference();
     FAULT_ON_NULL_ARG(key);
 
-    keyHashCode = stack.Arg2().NumericByRef().s4;
-
     buckets = pThis[FIELD___buckets].DereferenceArray();
-    bucketsLength = buckets->m_numOfElements;
-
-    hashcode = InitHash(keyHashCode, bucketsLength, &seed, &incr);
 
-    bucketNumber = (int)(seed % (uint32_t)bucketsLength);
+    bucket = FindBucket(buckets, key, stack.Arg2().NumericByRef().s4, NULL);
 
-    do
+    if (bucket != NULL)
     {
-        bucketElement = ((CLR_RT_HeapBlock *)buckets->GetElement(bucketNumber));
-        bucket = bucketElement->Dereference();
-
-        if (bucket != NULL && bucket[BucketType::FIELD___key].Dereference() != NULL &&
-            (bucket[BucketType::FIELD___hash].NumericByRef().u4 == hashcode) &&
-            (CLR_RT_HeapBlock::ObjectsEqual(*bucket[BucketType::FIELD___key].Dereference(), *key, true)))
-        {
-            // Clear hash field, then key, then value
-
-            bucket[BucketType::FIELD___hash].NumericByRef().u4 = 0;
-            bucket[BucketType::FIELD___value].SetObjectReference(NULL);
-            bucket[BucketType::FIELD___key].SetObjectReference(NULL);
-
-            // subtract count field
-            pThis[FIELD___count].NumericByRef().s4--;
-
-            // update version
-            pThis[FIELD___version].NumericByRef().s4++;
+        // Clear hash field, then key, then value
+        // (the bucket stays in the array, it's still part of the probe sequence of other keys)
 
-            NANOCLR_SET_AND_LEAVE(S_OK)
-        }
+        bucket[BucketType::FIELD___hash].NumericByRef().u4 = 0;
+        bucket[BucketType::FIELD___value].SetObjectReference(NULL);
+        bucket[BucketType::FIELD___key].SetObjectReference(NULL);
 
-        bucketNumber = (int32_t)((bucketNumber + incr) % (uint32_t)bucketsLength);
+        // subtract count field
+        pThis[FIELD___count].NumericByRef().s4--;
 
-    } while (++entry < bucketsLength);
+        // update version
+        pThis[FIELD___version].NumericByRef().s4++;
+    }
 
     NANOCLR_NOCLEANUP();
 }
@@ -192,13 +241,8 @@ HRESULT Library_nf_system_collections_System_Collections_Hashtable::InsertNative
     NANOCLR_HEADER();
 
     bool add;
-    uint32_t entry = 0;
-    int32_t bucketNumber;
-    uint32_t hashcode;
     int32_t keyHashCode;
-    uint32_t seed;
-    uint32_t incr;
-    uint32_t bucketsLength;
+    int32_t freeSlot;
     CLR_RT_HeapBlock *key;
     CLR_RT_HeapBlock *newValue;
     CLR_RT_HeapBlock *bucket;
@@ -225,72 +269,60 @@ HRESULT Library_nf_system_collections_System_Collections_Hashtable::InsertNative
     }
 
     buckets = pThis[FIELD___buckets].DereferenceArray();
-    bucketsLength = buckets->m_numOfElements;
-
-    hashcode = InitHash(keyHashCode, bucketsLength, &seed, &incr);
 
-    bucketNumber = (int)(seed % bucketsLength);
+    // the whole probe sequence is checked for the key before taking a free slot, an emptied bucket can come before
+    // the one holding it
+    bucket = FindBucket(buckets, key, keyHashCode, &freeSlot);
 
-    do
+    if (bucket != NULL)
     {
-        bucketElement = ((CLR_RT_HeapBlock *)buckets->GetElement(bucketNumber));
-        bucket = bucketElement->Dereference();
-
-        // Insert the key/value pair into this bucket if this bucket is empty
-        if (bucket == NULL || (bucket != NULL && bucket[BucketType::FIELD___key].Dereference() == NULL))
+        if (add)
         {
-            // We pretty much have to insert in this order.  Don't set hash
-            // code until the value & key are set appropriately.
-
-            CLR_RT_TypeDef_Index bucketTypeDef;
-            CLR_RT_HeapBlock newBucket;
-
-            if (bucket == NULL)
-            {
-                // find <Bucket> type, don't bother checking the result as it exists for sure
-                g_CLR_RT_TypeSystem.FindTypeDef("Bucket", "System.Collections", bucketTypeDef);
-                // create a new <Bucket>
-                NANOCLR_CHECK_HRESULT(g_CLR_RT_ExecutionEngine.NewObjectFromIndex(newBucket, bucketTypeDef));
-                bucketElement->LoadFromReference(newBucket);
-                bucket = bucketElement->Dereference();
-            }
-
-            bucket[BucketType::FIELD___hash].NumericByRef().u4 = hashcode;
-            bucket[BucketType::FIELD___value].SetObjectReference(newValue);
-            bucket[BucketType::FIELD___key].SetObjectReference(key);
-
-            // add count field
-            pThis[FIELD___count].NumericByRef().s4++;
+            // entry already exists
+            NANOCLR_SET_AND_LEAVE(CLR_E_INVALID_PARAMETER)
+        }
 
-            // update version
-            pThis[FIELD___version].NumericByRef().s4++;
+        bucket[BucketType::FIELD___value].SetObjectReference(newValue);
 
-            NANOCLR_SET_AND_LEAVE(S_OK)
-        }
+        // update version
+        pThis[FIELD___version].NumericByRef().s4++;
 
-        if (bucket != NULL &&
-            (CLR_RT_HeapBlock::ObjectsEqual(*bucket[BucketType::FIELD___key].Dereference(), *key, true)))
-        {
-            if (add)
-            {
-                // entry already exists
-                NANOCLR_SET_AND_LEAVE(CLR_E_INVALID_PARAMETER)
-            }
+        NANOCLR_SET_AND_LEAVE(S_OK)
+    }
 
-            bucket[BucketType::FIELD___value].SetObjectReference(newValue);
+    if (freeSlot < 0)
+    {
+        // got here, found no place for this
+        NANOCLR_SET_AND_LEAVE(CLR_E_INVALID_OPERATION)
+    }
 
-            // update version
-            pThis[FIELD___version].NumericByRef().s4++;
+    bucketElement = (CLR_RT_HeapBlock *)buckets->GetElement(freeSlot);
+    bucket = bucketElement->Dereference();
 
-            NANOCLR_SET_AND_LEAVE(S_OK)
-        }
+    if (bucket == NULL)
+    {
+        CLR_RT_TypeDef_Index bucketTypeDef;
+        CLR_RT_HeapBlock newBucket;
+
+        // find <Bucket> type, don't bother checking the result as it exists for sure
+        g_CLR_RT_TypeSystem.FindTypeDef("Bucket", "System.Collections", bucketTypeDef);
+        // create a new <Bucket>
+        NANOCLR_CHECK_HRESULT(g_CLR_RT_ExecutionEngine.NewObjectFromIndex(newBucket, bucketTypeDef));
+        bucketElement->LoadFromReference(newBucket);
+        bucket = bucketElement->Dereference();
+    }
 
-        bucketNumber = (int32_t)((bucketNumber + incr) % bucketsLength);
+    // We pretty much have to insert in this order.  Don't set hash
+    // code until the value & key are set appropriately.
+    bucket[BucketType::FIELD___hash].NumericByRef().u4 = (uint32_t)keyHashCode;
+    bucket[BucketType::FIELD___value].SetObjectReference(newValue);
+    bucket[BucketType::FIELD___key].SetObjectReference(key);
 
-    } while (++entry < bucketsLength);
+    // add count field
+    pThis[FIELD___count].NumericByRef().s4++;
 
-    // got here, found no place for this
-    NANOCLR_SET_AND_LEAVE(CLR_E_INVALID_OPERATION)
+    // update version
+    pThis[FIELD___version].NumericByRef().s4++;
 
     NANOCLR_NOCLEANUP();
 }
@@ -300,16 +332,8 @@ HRESULT Library_nf_system_collections_System_Collections_Hashtable::GetNative___
 {
     NANOCLR_HEADER();
 
-    int32_t entry = 0;
-    int32_t bucketNumber;
-    uint32_t hashcode;
-    int32_t keyHashCode;
-    uint32_t seed;
-    uint32_t incr;
-    int32_t bucketsLength;
     CLR_RT_HeapBlock *key;
     CLR_RT_HeapBlock *bucket;
-    CLR_RT_HeapBlock *bucketElement;
     CLR_RT_HeapBlock_Array *buckets;
 
     CLR_RT_HeapBlock *pThis;
@@ -320,32 +344,12 @@ HRESULT Library_nf_system_collections_System_Collections_Hashtable::GetNative___
     key = stack.Arg1().Dereference();
     FAULT_ON_NULL_ARG(key);
 
-    keyHashCode = stack.Arg2().NumericByRef().s4;
-
     buckets = pThis[FIELD___buckets].DereferenceArray();
-    bucketsLength = buckets->m_numOfElements;
 
-    hashcode = InitHash(keyHashCode, bucketsLength, &seed, &incr);
+    bucket = FindBucket(buckets, key, stack.Arg2().NumericByRef().s4, NULL);
 
-    bucketNumber = (int)(seed % (uint32_t)bucketsLength);
-
-    do
-    {
-        bucketElement = ((CLR_RT_HeapBlock *)buckets->GetElement(bucketNumber));
-        bucket = bucketElement->Dereference();
-
-        if (bucket != NULL && (bucket[BucketType::FIELD___hash].NumericByRef().u4 == hashcode) &&
-            (CLR_RT_HeapBlock::ObjectsEqual(*bucket[BucketType::FIELD___key].Dereference(), *key, true)))
-        {
-            stack.SetResult_Object(bucket[BucketType::FIELD___value].Dereference());
-            NANOCLR_SET_AND_LEAVE(S_OK)
-        }
-
-        bucketNumber = (int32_t)((bucketNumber + incr) % (uint32_t)bucketsLength);
-    } while (++entry < bucketsLength);
-
-    // no key found
-    stack.SetResult_Object(NULL);
+    // no key found returns null
+    stack.SetResult_Object(bucket != NULL ? bucket[BucketType::FIELD___value].Dereference() : NULL);
 
     NANOCLR_NOCLEANUP();
 }
@@ -392,15 +396,13 @@ HRESULT Library_nf_system_collections_System_Collections_Hashtable::Expand(CLR_R
     int32_t newSize;
     uint32_t seed;
     uint32_t incr;
-    int32_t newBucketNumber;
+    uint32_t newBucketNumber;
 
     CLR_RT_HeapBlock *oldBucket;
-    CLR_RT_HeapBlock *oldBucketElement;
-    CLR_RT_HeapBlock *newBucketElement;
-    CLR_RT_HeapBlock *bucket;
+    CLR_RT_HeapBlock *oldElements;
+    CLR_RT_HeapBlock *newElements;
     CLR_RT_HeapBlock newBucketsHB;
     CLR_RT_HeapBlock_Array *buckets;
-    CLR_RT_HeapBlock_Array *newBuckets;
     CLR_RT_HeapBlock *pThis;
     CLR_RT_TypeDef_Index bucketTypeDef;
 
@@ -441,49 +443,29 @@ HRESULT Library_nf_system_collections_System_Collections_Hashtable::Expand(CLR_R
     }
 
     NANOCLR_CHECK_HRESULT(CLR_RT_HeapBlock_Array::CreateInstance(newBucketsHB, newSize, bucketTypeDef))
-    newBuckets = newBucketsHB.DereferenceArray();
 
+    oldElements = (CLR_RT_HeapBlock *)buckets->GetFirstElement();
+    newElements = (CLR_RT_HeapBlock *)newBucketsHB.DereferenceArray()->GetFirstElement();
+
+    // The bucket objects are moved to the new array as they are, only the ones in use are kept. Nothing is allocated
+    // per entry and the emptied buckets don't carry over to the new probe sequences.
     for (uint32_t bucketNumber = 0; bucketNumber < bucketsLength; bucketNumber++)
     {
-        oldBucketElement = ((CLR_RT_HeapBlock *)buckets->GetElement(bucketNumber));
-        oldBucket = oldBucketElement->Dereference();
+        oldBucket = oldElements[bucketNumber].Dereference();
 
-        // sanity check: can only clear buckets that already have objects
         if (oldBucket != NULL && oldBucket[BucketType::FIELD___key].Dereference() != NULL)
         {
             seed = oldBucket[BucketType::FIELD___hash].NumericByRef().u4;
             incr = 1 + ((seed * HashPrime) % ((uint32_t)newSize - 1));
 
-            newBucketNumber = (int)(seed % (uint32_t)newSize);
+            newBucketNumber = seed % (uint32_t)newSize;
 
-            while (true)
+            while (newElements[newBucketNumber].Dereference() != NULL)
             {
-                newBucketElement = ((CLR_RT_HeapBlock *)newBuckets->GetElement(newBucketNumber));
-                bucket = newBucketElement->Dereference();
-
-                if (bucket == NULL || bucket[BucketType::FIELD___key].Dereference() == NULL)
-                {
-                    // create a new <Bucket>
-                    CLR_RT_HeapBlock newBucket;
-
-                    NANOCLR_CHECK_HRESULT(g_CLR_RT_ExecutionEngine.NewObjectFromIndex(newBucket, bucketTypeDef))
-
-                    newBucketElement->LoadFromReference(newBucket);
-                    bucket = newBucketElement->Dereference();
-
-                    // copy over from old bucket
-                    bucket[BucketType::FIELD___hash].NumericByRef().u4 =
-                        oldBucket[BucketType::FIELD___hash].NumericByRef().u4;
-                    bucket[BucketType::FIELD___value].SetObjectReference(
-                        oldBucket[BucketType::FIELD___value].Dereference());
-                    bucket[BucketType::FIELD___key].SetObjectReference(
-                        oldBucket[BucketType::FIELD___key].Dereference());
-
-                    break;
-                }
-
-                newBucketNumber = (int)((newBucketNumber + incr) % (uint32_t)newSize);
+                newBucketNumber = (newBucketNumber + incr) % (uint32_t)newSize;
             }
+
+            newElements[newBucketNumber].SetObjectReference(oldBucket);
         }
     }
 
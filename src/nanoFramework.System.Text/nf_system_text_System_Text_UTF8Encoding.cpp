@@ -18,7 +18,7 @@ HRESULT Library_nf_system_text_System_Text_UTF8Encoding::GetBytes___SZARRAY_U1__
 
     str = stack.Arg1().RecoverString();
     FAULT_ON_NULL(str);
-    cBytes = hal_strlen_s(str);
+    cBytes = stack.Arg1().DereferenceString()->GetLengthInBytes();
 
     NANOCLR_CHECK_HRESULT(
         CLR_RT_HeapBlock_Array::CreateInstance(ret, (CLR_UINT32)cBytes, g_CLR_RT_WellKnownTypes.m_UInt8));
@@ -44,24 +44,37 @@ HRESULT Library_nf_system_text_System_Text_UTF8Encoding::GetBytes___I4__STRING__
 
     const CLR_UINT8 *i;
     const CLR_UINT8 *j;
-    CLR_RT_UnicodeHelper uh;
+    CLR_RT_HeapBlock_String *strObj;
     int strLength;
 
     FAULT_ON_NULL(str);
     FAULT_ON_NULL(pArrayBytes);
 
-    uh.SetInputUTF8(str);
-    strLength = uh.CountNumberOfCharacters();
+    // the length is cached in the string, it's computed (and the text validated) only once
+    strObj = stack.Arg1().DereferenceString();
+    strLength = strObj->GetLength();
     if (strLength < 0)
         NANOCLR_SET_AND_LEAVE(CLR_E_WRONG_TYPE);
 
     if ((strIdx + strCnt) > (CLR_INT32)strLength)
         NANOCLR_SET_AND_LEAVE(CLR_E_OUT_OF_RANGE);
 
-    uh.ConvertFromUTF8(strIdx, true);
-    i = uh.m_inputUTF8;
-    uh.ConvertFromUTF8(strCnt, true);
-    j = uh.m_inputUTF8;
+    if (strObj->IsAscii())
+    {
+        // one byte per char
+        i = (const CLR_UINT8 *)str + strIdx;
+        j = i + strCnt;
+    }
+    else
+    {
+        CLR_RT_UnicodeHelper uh;
+
+        uh.SetInputUTF8(str);
+        uh.ConvertFromUTF8(strIdx, true);
+        i = uh.m_inputUTF8;
+        uh.ConvertFromUTF8(strCnt, true);
+        j = uh.m_inputUTF8;
+    }
 
     if ((byteIdx + j - i) > (CLR_INT32)pArrayBytes->m_numOfElements)
         NANOCLR_SET_AND_LEAVE(CLR_E_OUT_OF_RANGE);
@@ -100,13 +113,9 @@ HRESULT Library_nf_system_text_System_Text_UTF8Encoding::Helper__GetChars(CLR_RT
     NANOCLR_HEADER();
 
     const char *szText;
-    int cBytesCopy;
-    CLR_RT_HeapBlock ref;
-    CLR_RT_HeapBlock_Array *pArrayBytesCopy;
-    CLR_RT_HeapBlock_Array *arrTmp;
-
-    ref.SetObjectReference(NULL);
-    CLR_RT_ProtectFromGC gc(ref);
+    int cChars;
+    CLR_RT_UnicodeHelper uh;
+    CLR_RT_HeapBlock_Array *arrChars;
 
     CLR_RT_HeapBlock_Array *pArrayBytes = stack.Arg1().DereferenceArray();
     CLR_INT32 byteIdx = fIndexed ? stack.Arg2().NumericByRef().s4 : 0;
@@ -119,18 +128,24 @@ HRESULT Library_nf_system_text_System_Text_UTF8Encoding::Helper__GetChars(CLR_RT
     if ((byteIdx + byteCnt) > (CLR_INT32)pArrayBytes->m_numOfElements)
         NANOCLR_SET_AND_LEAVE(CLR_E_OUT_OF_RANGE);
 
-    cBytesCopy = byteCnt + 1;
+    // decode straight from the byte array, the input is bounded by the byte count so it needs no terminator
+    szText = (const char *)pArrayBytes->GetElement(byteIdx);
 
-    /* Copy the array to a temporary buffer to create a zero-terminated string */
-    NANOCLR_CHECK_HRESULT(CLR_RT_HeapBlock_Array::CreateInstance(ref, cBytesCopy, g_CLR_RT_WellKnownTypes.m_UInt8));
+    uh.SetInputUTF8(szText);
+    cChars = uh.CountNumberOfCharacters(-1, byteCnt);
+    if (cChars < 0)
+        NANOCLR_SET_AND_LEAVE(CLR_E_WRONG_TYPE);
 
-    pArrayBytesCopy = ref.DereferenceArray();
-    szText = (const char *)pArrayBytesCopy->GetFirstElement();
+    NANOCLR_CHECK_HRESULT(
+        CLR_RT_HeapBlock_Array::CreateInstance(stack.PushValueAndClear(), cChars, g_CLR_RT_WellKnownTypes.m_Char));
 
-    hal_strncpy_s((char *)szText, cBytesCopy, (const char *)pArrayBytes->GetElement(byteIdx), byteCnt);
+    arrChars = stack.TopValue().DereferenceArray();
 
-    NANOCLR_CHECK_HRESULT(
-        Library_corlib_native_System_String::ConvertToCharArray(szText, stack.PushValueAndClear(), arrTmp, 0, -1));
+    uh.SetInputUTF8(szText);
+    uh.m_outputUTF16 = (CLR_UINT16 *)arrChars->GetFirstElement();
+    uh.m_outputUTF16_size = cChars;
+
+    uh.ConvertFromUTF8(cChars, false, byteCnt);
 
     NANOCLR_NOCLEANUP();
 }
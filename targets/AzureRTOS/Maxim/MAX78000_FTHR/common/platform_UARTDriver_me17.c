@@ -113,7 +113,6 @@ int NanoUART_RevB_AsyncHandler(mxc_uart_revb_regs_t *uart)
 {
     volatile uint32_t numToWrite, numToRead, flags;
     mxc_uart_req_t *req;
-    uint8_t tmp;
 
     volatile int uartNum = MXC_UART_GET_IDX((mxc_uart_regs_t *)uart);
 
@@ -193,16 +192,26 @@ int NanoUART_RevB_AsyncHandler(mxc_uart_revb_regs_t *uart)
 
             if (numToRead)
             {
-                // check available space
-                numToRead = numToRead <= (WPRingBuffer._capacity - WPRingBuffer._size)
-                                ? numToRead
-                                : (WPRingBuffer._capacity - WPRingBuffer._size);
+                size_t freeSpace;
+                uint8_t *destination = NanoRingBuffer_PeekWrite(&WPRingBuffer, &freeSpace);
 
-                while ((WPRingBuffer._capacity - WPRingBuffer._size) && numToRead > 0)
+                // read straight from the FIFO into the ring buffer free space
+                // (up to 2 chunks if the free space wraps around the end of the buffer)
+                while (freeSpace > 0 && numToRead > 0)
                 {
-                    MXC_UART_ReadRXFIFO((mxc_uart_regs_t *)uart, &tmp, 1);
-                    NanoRingBuffer_Push(&WPRingBuffer, tmp);
-                    numToRead--;
+                    size_t chunkSize = numToRead <= freeSpace ? numToRead : freeSpace;
+
+                    chunkSize = MXC_UART_ReadRXFIFO((mxc_uart_regs_t *)uart, destination, chunkSize);
+                    NanoRingBuffer_CommitWrite(&WPRingBuffer, chunkSize);
+
+                    if (chunkSize == 0)
+                    {
+                        break;
+                    }
+
+                    numToRead -= chunkSize;
+
+                    destination = NanoRingBuffer_PeekWrite(&WPRingBuffer, &freeSpace);
                 }
 
                 // if there are still bytes to read, flush them